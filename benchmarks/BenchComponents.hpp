@@ -0,0 +1,136 @@
+/*
+** EPITECH PROJECT, 2018
+** JFEntityComponentSystem
+** File description:
+** BenchComponents.hpp
+*/
+
+/* Created the 16/10/2026 at 22:31 by jfrabel */
+
+#ifndef JFENTITYCOMPONENTSYSTEM_BENCHCOMPONENTS_HPP
+#define JFENTITYCOMPONENTSYSTEM_BENCHCOMPONENTS_HPP
+
+#include <vector>
+#include "ECSWrapper.hpp"
+
+/*!
+ * @namespace bench
+ * @brief The namespace of the jfecs benchmarks
+ */
+namespace bench {
+
+    /*!
+     * @struct Position
+     * @brief A small component
+     */
+    struct Position : jf::components::Component {
+        explicit Position(jf::entities::Entity &entity, float x = 0, float y = 0)
+            : Component(entity), x(x), y(y)
+        {}
+        float x;
+        float y;
+    };
+
+    /*!
+     * @struct Velocity
+     * @brief A small component
+     */
+    struct Velocity : jf::components::Component {
+        explicit Velocity(jf::entities::Entity &entity, float x = 1, float y = 1)
+            : Component(entity), x(x), y(y)
+        {}
+        float x;
+        float y;
+    };
+
+    /*!
+     * @struct Health
+     * @brief A small component
+     */
+    struct Health : jf::components::Component {
+        explicit Health(jf::entities::Entity &entity, int value = 100)
+            : Component(entity), value(value)
+        {}
+        int value;
+    };
+
+    /*!
+     * @struct Tag
+     * @brief A small component stored with a sparse set index
+     */
+    struct Tag : jf::components::Component {
+        explicit Tag(jf::entities::Entity &entity, int value = 0)
+            : Component(entity), value(value)
+        {}
+        int value;
+    };
+
+    struct Particle;
+
+    /*!
+     * @class EntityFixture
+     * @brief Create entities having the four benchmark components and destroy them on destruction
+     */
+    class EntityFixture {
+    public:
+        /*!
+         * @brief ctor
+         * @param count The number of entities to create
+         */
+        explicit EntityFixture(std::size_t count)
+            : _ids()
+        {
+            auto &manager = jf::entities::EntityManager::getInstance();
+            _ids.reserve(count);
+            for (std::size_t i = 0; i < count; ++i) {
+                auto entity = manager.createEntity("bench");
+                entity->assignComponent<Position>();
+                entity->assignComponent<Velocity>();
+                entity->assignComponent<Health>();
+                entity->assignComponent<Tag>();
+                _ids.push_back(entity->getID());
+            }
+        }
+
+        /*!
+         * @brief dtor
+         */
+        ~EntityFixture()
+        {
+            auto &manager = jf::entities::EntityManager::getInstance();
+            for (auto &id : _ids)
+                manager.deleteEntity(id);
+        }
+
+        /*!
+         * @brief Get the ids of the created entities
+         * @return The ids
+         */
+        const std::vector<jf::internal::ID> &getIDs() const
+        {
+            return _ids;
+        }
+
+    private:
+        std::vector<jf::internal::ID> _ids; /*!< The ids of the created entities */
+    };
+}
+
+SPARSE_SET_STORAGE(bench::Tag)
+NO_LIFECYCLE_EVENTS(bench::Particle)
+
+namespace bench {
+
+    /*!
+     * @struct Particle
+     * @brief A small component not emitting lifecycle events
+     */
+    struct Particle : jf::components::Component {
+        explicit Particle(jf::entities::Entity &entity, float life = 1)
+            : Component(entity), life(life)
+        {}
+        float life;
+    };
+}
+
+#endif //JFENTITYCOMPONENTSYSTEM_BENCHCOMPONENTS_HPP
@@ -0,0 +1,127 @@
+/*
+** EPITECH PROJECT, 2018
+** JFEntityComponentSystem
+** File description:
+** Benchmark.cpp
+*/
+
+/* Created the 16/10/2026 at 22:31 by jfrabel */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#ifdef __linux__
+#include <unistd.h>
+#endif
+#include "Benchmark.hpp"
+
+std::atomic<std::size_t> bench::allocations(0);
+
+bench::Context::Context(const std::string &name, std::size_t arg, const std::chrono::nanoseconds &minTime)
+    : _name(name), _arg(arg), _minTime(minTime), _results()
+{
+
+}
+
+std::size_t bench::Context::getArg() const
+{
+    return _arg;
+}
+
+const std::vector<bench::Result> &bench::Context::getResults() const
+{
+    return _results;
+}
+
+void bench::Context::record(std::size_t operations, std::size_t iterations, const std::chrono::nanoseconds &elapsed,
+                            std::size_t allocated)
+{
+    Result result = {_name, _arg, iterations,
+        static_cast<double>(elapsed.count()) / static_cast<double>(operations),
+        static_cast<double>(allocated) / static_cast<double>(operations),
+        getResidentMemory()};
+    _results.push_back(result);
+}
+
+bench::Registrar::Registrar(const std::string &name, const std::vector<std::size_t> &args,
+                            const std::function<void(Context &)> &function)
+{
+    Benchmark benchmark = {name, args, function};
+    getBenchmarks().push_back(benchmark);
+}
+
+std::vector<bench::Benchmark> &bench::getBenchmarks()
+{
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+std::size_t bench::getResidentMemory()
+{
+#ifdef __linux__
+    FILE *file = std::fopen("/proc/self/statm", "r");
+    if (file == nullptr)
+        return 0;
+    unsigned long size = 0;
+    unsigned long resident = 0;
+    int read = std::fscanf(file, "%lu %lu", &size, &resident);
+    std::fclose(file);
+    if (read != 2)
+        return 0;
+    return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE)) / 1024;
+#else
+    return 0;
+#endif
+}
+
+int bench::run(int ac, char **av)
+{
+    bool json = false;
+    std::string filter;
+    std::chrono::nanoseconds minTime = std::chrono::milliseconds(200);
+    std::size_t maxArg = static_cast<std::size_t>(-1);
+    for (int i = 1; i < ac; ++i) {
+        if (std::strcmp(av[i], "--json") == 0) {
+            json = true;
+        } else if (std::strncmp(av[i], "--filter=", 9) == 0) {
+            filter = av[i] + 9;
+        } else if (std::strncmp(av[i], "--min-time=", 11) == 0) {
+            minTime = std::chrono::milliseconds(std::strtoul(av[i] + 11, nullptr, 10));
+        } else if (std::strncmp(av[i], "--max-arg=", 10) == 0) {
+            maxArg = std::strtoul(av[i] + 10, nullptr, 10);
+        } else {
+            std::cerr << "Usage: " << av[0] << " [--json] [--filter=<text>] [--min-time=<ms>] [--max-arg=<n>]" << std::endl;
+            return 1;
+        }
+    }
+    std::vector<Result> results;
+    if (!json)
+        std::printf("%-32s %10s %12s %14s %12s %12s\n", "benchmark", "arg", "iterations", "ns/op", "allocs/op", "rss KiB");
+    for (auto &benchmark : getBenchmarks()) {
+        if (benchmark.name.find(filter) == std::string::npos)
+            continue;
+        for (auto arg : benchmark.args) {
+            if (arg > maxArg)
+                continue;
+            Context context(benchmark.name, arg, minTime);
+            benchmark.function(context);
+            for (auto &result : context.getResults()) {
+                if (!json)
+                    std::printf("%-32s %10zu %12zu %14.2f %12.3f %12zu\n", result.name.c_str(), result.arg,
+                        result.iterations, result.nsPerOp, result.allocsPerOp, result.rssKiB);
+                results.push_back(result);
+            }
+        }
+    }
+    if (json) {
+        std::printf("{\"benchmarks\":[");
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            std::printf("%s\n{\"name\":\"%s\",\"arg\":%zu,\"iterations\":%zu,\"ns_per_op\":%.3f,\"allocs_per_op\":%.4f,\"rss_kib\":%zu}",
+                i == 0 ? "" : ",", results[i].name.c_str(), results[i].arg, results[i].iterations,
+                results[i].nsPerOp, results[i].allocsPerOp, results[i].rssKiB);
+        }
+        std::printf("\n]}\n");
+    }
+    return 0;
+}
@@ -0,0 +1,180 @@
+/*
+** EPITECH PROJECT, 2018
+** JFEntityComponentSystem
+** File description:
+** Benchmark.hpp
+*/
+
+/* Created the 16/10/2026 at 22:31 by jfrabel */
+
+#ifndef JFENTITYCOMPONENTSYSTEM_BENCHMARK_HPP
+#define JFENTITYCOMPONENTSYSTEM_BENCHMARK_HPP
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+/*!
+ * @brief Declare a benchmark run once for each given argument
+ * @param function The name of the benchmark
+ * @param ... The arguments (entity counts, listener counts...) the benchmark is run with
+ *
+ * The macro must be followed by the body of the benchmark, the body gets a bench::Context named context.
+ */
+#define BENCHMARK(function, ...) \
+    static void function(bench::Context &context); \
+    static bench::Registrar function##Registrar(#function, {__VA_ARGS__}, function); \
+    static void function(bench::Context &context)
+
+/*!
+ * @namespace bench
+ * @brief The namespace of the jfecs benchmarks
+ */
+namespace bench {
+
+    extern std::atomic<std::size_t> allocations; /*!< The number of calls to operator new since the start of the program */
+
+    /*!
+     * @brief Prevent the compiler from optimizing away a value
+     * @tparam T The type of the value
+     * @param value The value that must be computed
+     */
+    template<typename T>
+    void doNotOptimize(const T &value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "g"(&value) : "memory");
+#else
+        static volatile const T *sink;
+        sink = &value;
+#endif
+    }
+
+    /*!
+     * @struct Result
+     * @brief The measures of a benchmark for one argument
+     */
+    struct Result {
+        std::string name; /*!< The name of the benchmark */
+        std::size_t arg; /*!< The argument of the run */
+        std::size_t iterations; /*!< The number of times the measured function was called */
+        double nsPerOp; /*!< The average duration of an operation in nanoseconds */
+        double allocsPerOp; /*!< The average number of allocations of an operation */
+        std::size_t rssKiB; /*!< The resident memory of the process after the run in KiB */
+    };
+
+    /*!
+     * @class Context
+     * @brief Given to a benchmark to know its argument and measure its operations
+     */
+    class Context {
+    public:
+        /*!
+         * @brief ctor
+         * @param name The name of the benchmark
+         * @param arg The argument of the run
+         * @param minTime The minimum time spent measuring
+         */
+        Context(const std::string &name, std::size_t arg, const std::chrono::nanoseconds &minTime);
+
+        /*!
+         * @brief Get the argument of the run
+         * @return The argument
+         */
+        std::size_t getArg() const;
+
+        /*!
+         * @brief Call a function until minTime is spent and record the average cost of an operation
+         * @tparam Func The type of the function
+         * @param operations The number of operations done by one call of the function
+         * @param func The function to measure (called once more before measuring to warm up)
+         */
+        template<typename Func>
+        void measure(std::size_t operations, Func func)
+        {
+            func();
+            std::size_t iterations = 0;
+            std::size_t allocationsBefore = allocations.load();
+            auto begin = std::chrono::steady_clock::now();
+            std::chrono::nanoseconds elapsed(0);
+            do {
+                func();
+                ++iterations;
+                elapsed = std::chrono::steady_clock::now() - begin;
+            } while (elapsed < _minTime);
+            std::size_t allocated = allocations.load() - allocationsBefore;
+            record(operations * iterations, iterations, elapsed, allocated);
+        }
+
+        /*!
+         * @brief Get the measures
+         * @return The measures of each call to measure
+         */
+        const std::vector<Result> &getResults() const;
+
+    private:
+        /*!
+         * @brief Add a measure
+         * @param operations The number of operations measured
+         * @param iterations The number of calls of the measured function
+         * @param elapsed The time spent
+         * @param allocated The number of allocations done
+         */
+        void record(std::size_t operations, std::size_t iterations, const std::chrono::nanoseconds &elapsed, std::size_t allocated);
+
+    private:
+        std::string _name; /*!< The name of the benchmark */
+        std::size_t _arg; /*!< The argument of the run */
+        std::chrono::nanoseconds _minTime; /*!< The minimum time spent measuring */
+        std::vector<Result> _results; /*!< The measures */
+    };
+
+    /*!
+     * @struct Benchmark
+     * @brief A registered benchmark
+     */
+    struct Benchmark {
+        std::string name; /*!< The name of the benchmark */
+        std::vector<std::size_t> args; /*!< The arguments the benchmark is run with */
+        std::function<void(Context &)> function; /*!< The benchmark */
+    };
+
+    /*!
+     * @class Registrar
+     * @brief Register a benchmark on construction (use BENCHMARK)
+     */
+    class Registrar {
+    public:
+        /*!
+         * @brief ctor
+         * @param name The name of the benchmark
+         * @param args The arguments the benchmark is run with
+         * @param function The benchmark
+         */
+        Registrar(const std::string &name, const std::vector<std::size_t> &args, const std::function<void(Context &)> &function);
+    };
+
+    /*!
+     * @brief Get the registered benchmarks
+     * @return A reference to the benchmarks
+     */
+    std::vector<Benchmark> &getBenchmarks();
+
+    /*!
+     * @brief Get the resident memory of the process
+     * @return The resident memory in KiB (0 if unknown on this platform)
+     */
+    std::size_t getResidentMemory();
+
+    /*!
+     * @brief Run the benchmarks selected by the command line and print the results
+     * @param ac The number of arguments
+     * @param av The arguments (--json, --filter=<text>, --min-time=<ms>, --max-arg=<n>)
+     * @return The exit status of the program
+     */
+    int run(int ac, char **av);
+}
+
+#endif //JFENTITYCOMPONENTSYSTEM_BENCHMARK_HPP
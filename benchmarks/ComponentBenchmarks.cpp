@@ -0,0 +1,196 @@
+/*
+** EPITECH PROJECT, 2018
+** JFEntityComponentSystem
+** File description:
+** ComponentBenchmarks.cpp
+*/
+
+/* Created the 16/10/2026 at 22:31 by jfrabel */
+
+#include "Benchmark.hpp"
+#include "BenchComponents.hpp"
+#include "Events.hpp"
+
+BENCHMARK(assignRemoveComponent, 10000, 100000)
+{
+    auto &manager = jf::entities::EntityManager::getInstance();
+    std::vector<jf::internal::ID> ids;
+    for (std::size_t i = 0; i < context.getArg(); ++i)
+        ids.push_back(manager.createEntity("bench")->getID());
+    context.measure(context.getArg(), [&manager, &ids]() {
+        for (auto &id : ids) {
+            auto entity = manager.getEntityByID(id);
+            entity->assignComponent<bench::Position>(1.0f, 2.0f);
+            entity->removeComponent<bench::Position>();
+        }
+    });
+    for (auto &id : ids)
+        manager.deleteEntity(id);
+}
+
+BENCHMARK(assignRemoveSparseComponent, 10000, 100000)
+{
+    auto &manager = jf::entities::EntityManager::getInstance();
+    std::vector<jf::internal::ID> ids;
+    for (std::size_t i = 0; i < context.getArg(); ++i)
+        ids.push_back(manager.createEntity("bench")->getID());
+    context.measure(context.getArg(), [&manager, &ids]() {
+        for (auto &id : ids) {
+            auto entity = manager.getEntityByID(id);
+            entity->assignComponent<bench::Tag>(1);
+            entity->removeComponent<bench::Tag>();
+        }
+    });
+    for (auto &id : ids)
+        manager.deleteEntity(id);
+}
+
+/*!
+ * @brief Assign and remove a component on entities while something listens to the lifecycle events
+ * @tparam C The type of component
+ * @param context The context of the benchmark
+ */
+template<typename C>
+static void assignRemoveListened(bench::Context &context)
+{
+    auto &manager = jf::entities::EntityManager::getInstance();
+    auto &events = jf::events::EventManager::getInstance();
+    std::size_t created = 0;
+    auto listener = events.addListener<std::size_t, jf::events::ComponentCreatedEvent<jf::components::Component>>(&created,
+        [](std::size_t *count, jf::events::ComponentCreatedEvent<jf::components::Component>) noexcept {
+            ++*count;
+        });
+    std::vector<jf::internal::ID> ids;
+    for (std::size_t i = 0; i < context.getArg(); ++i)
+        ids.push_back(manager.createEntity("bench")->getID());
+    context.measure(context.getArg(), [&manager, &ids]() {
+        for (auto &id : ids) {
+            auto entity = manager.getEntityByID(id);
+            entity->assignComponent<C>();
+            entity->removeComponent<C>();
+        }
+    });
+    for (auto &id : ids)
+        manager.deleteEntity(id);
+    events.removeListener(listener);
+}
+
+BENCHMARK(assignRemoveListenedComponent, 10000, 100000)
+{
+    assignRemoveListened<bench::Position>(context);
+}
+
+BENCHMARK(assignRemoveMutedComponent, 10000, 100000)
+{
+    assignRemoveListened<bench::Particle>(context);
+}
+
+BENCHMARK(getComponent, 10000, 100000, 1000000)
+{
+    auto &manager = jf::entities::EntityManager::getInstance();
+    bench::EntityFixture fixture(context.getArg());
+    std::vector<jf::entities::EntityHandler> entities;
+    for (auto &id : fixture.getIDs())
+        entities.push_back(manager.getEntityByID(id));
+    context.measure(context.getArg(), [&entities]() {
+        float sum = 0;
+        for (auto &entity : entities)
+            sum += entity->getComponent<bench::Position>()->x;
+        bench::doNotOptimize(sum);
+    });
+}
+
+BENCHMARK(getSparseComponent, 10000, 100000, 1000000)
+{
+    auto &manager = jf::entities::EntityManager::getInstance();
+    bench::EntityFixture fixture(context.getArg());
+    std::vector<jf::entities::EntityHandler> entities;
+    for (auto &id : fixture.getIDs())
+        entities.push_back(manager.getEntityByID(id));
+    context.measure(context.getArg(), [&entities]() {
+        int sum = 0;
+        for (auto &entity : entities)
+            sum += entity->getComponent<bench::Tag>()->value;
+        bench::doNotOptimize(sum);
+    });
+}
+
+BENCHMARK(applyToEach1, 10000, 100000, 1000000)
+{
+    auto &manager = jf::entities::EntityManager::getInstance();
+    bench::EntityFixture fixture(context.getArg());
+    context.measure(context.getArg(), [&manager]() {
+        manager.applyToEach<bench::Position>([](jf::entities::EntityHandler, jf::components::ComponentHandler<bench::Position> position) {
+            position->x += 1;
+        });
+    });
+}
+
+BENCHMARK(applyToEach2, 10000, 100000, 1000000)
+{
+    auto &manager = jf::entities::EntityManager::getInstance();
+    bench::EntityFixture fixture(context.getArg());
+    context.measure(context.getArg(), [&manager]() {
+        manager.applyToEach<bench::Position, bench::Velocity>([](jf::entities::EntityHandler,
+            jf::components::ComponentHandler<bench::Position> position, jf::components::ComponentHandler<bench::Velocity> velocity) {
+            position->x += velocity->x;
+            position->y += velocity->y;
+        });
+    });
+}
+
+BENCHMARK(applyToEach3, 10000, 100000, 1000000)
+{
+    auto &manager = jf::entities::EntityManager::getInstance();
+    bench::EntityFixture fixture(context.getArg());
+    context.measure(context.getArg(), [&manager]() {
+        manager.applyToEach<bench::Position, bench::Velocity, bench::Health>([](jf::entities::EntityHandler,
+            jf::components::ComponentHandler<bench::Position> position, jf::components::ComponentHandler<bench::Velocity> velocity,
+            jf::components::ComponentHandler<bench::Health> health) {
+            position->x += velocity->x;
+            health->value -= 1;
+        });
+    });
+}
+
+BENCHMARK(applyToEach4, 10000, 100000, 1000000)
+{
+    auto &manager = jf::entities::EntityManager::getInstance();
+    bench::EntityFixture fixture(context.getArg());
+    context.measure(context.getArg(), [&manager]() {
+        manager.applyToEach<bench::Position, bench::Velocity, bench::Health, bench::Tag>([](jf::entities::EntityHandler,
+            jf::components::ComponentHandler<bench::Position> position, jf::components::ComponentHandler<bench::Velocity> velocity,
+            jf::components::ComponentHandler<bench::Health> health, jf::components::ComponentHandler<bench::Tag> tag) {
+            position->x += velocity->x;
+            health->value -= tag->value;
+        });
+    });
+}
+
+BENCHMARK(parallelApplyToEach2, 10000, 100000, 1000000)
+{
+    auto &manager = jf::entities::EntityManager::getInstance();
+    bench::EntityFixture fixture(context.getArg());
+    context.measure(context.getArg(), [&manager]() {
+        manager.parallelApplyToEach<bench::Position, bench::Velocity>([](jf::entities::EntityHandler,
+            jf::components::ComponentHandler<bench::Position> position, jf::components::ComponentHandler<bench::Velocity> velocity) {
+            position->x += velocity->x;
+            position->y += velocity->y;
+        });
+    });
+}
+
+BENCHMARK(hasComponents, 10000, 100000, 1000000)
+{
+    auto &manager = jf::entities::EntityManager::getInstance();
+    bench::EntityFixture fixture(context.getArg());
+    std::vector<jf::entities::EntityHandler> entities;
+    for (auto &id : fixture.getIDs())
+        entities.push_back(manager.getEntityByID(id));
+    context.measure(context.getArg(), [&entities]() {
+        std::size_t count = 0;
+        for (auto &entity : entities)
+            count += entity->hasComponents<bench::Position, bench::Velocity, bench::Health, bench::Tag>();
+        bench::doNotOptimize(count);
+    });
+}
@@ -0,0 +1,195 @@
+/*
+** EPITECH PROJECT, 2018
+** JFEntityComponentSystem
+** File description:
+** EntityBenchmarks.cpp
+*/
+
+/* Created the 16/10/2026 at 22:31 by jfrabel */
+
+#include <stdexcept>
+#include <string>
+#include "Benchmark.hpp"
+#include "BenchComponents.hpp"
+#include "Events.hpp"
+
+BENCHMARK(createDestroyEntities, 10000, 100000, 1000000)
+{
+    auto &manager = jf::entities::EntityManager::getInstance();
+    std::vector<jf::internal::ID> ids;
+    ids.reserve(context.getArg());
+    context.measure(context.getArg(), [&manager, &ids, &context]() {
+        for (std::size_t i = 0; i < context.getArg(); ++i)
+            ids.push_back(manager.createEntity("bench")->getID());
+        for (auto &id : ids)
+            manager.deleteEntity(id);
+        ids.clear();
+    });
+}
+
+BENCHMARK(deleteAllEntities, 10000, 100000)
+{
+    auto &manager = jf::entities::EntityManager::getInstance();
+    context.measure(context.getArg(), [&manager, &context]() {
+        for (std::size_t i = 0; i < context.getArg(); ++i)
+            manager.createEntity("bench");
+        manager.deleteAllEntities();
+    });
+}
+
+BENCHMARK(deleteAllEntitiesWithComponents, 10000, 100000)
+{
+    auto &manager = jf::entities::EntityManager::getInstance();
+    context.measure(context.getArg(), [&manager, &context]() {
+        manager.createEntities<bench::Position, bench::Velocity, bench::Tag>(context.getArg(), "bench");
+        manager.deleteAllEntities();
+    });
+}
+
+BENCHMARK(deleteAllEntitiesReleasingMemory, 10000, 100000)
+{
+    auto &manager = jf::entities::EntityManager::getInstance();
+    context.measure(context.getArg(), [&manager, &context]() {
+        manager.createEntities<bench::Position, bench::Velocity, bench::Tag>(context.getArg(), "bench");
+        manager.deleteAllEntities(true);
+    });
+}
+
+BENCHMARK(deleteAllEntitiesListened, 10000, 100000)
+{
+    auto &manager = jf::entities::EntityManager::getInstance();
+    auto &events = jf::events::EventManager::getInstance();
+    std::size_t touched = 0;
+    /* The entity of a component destroyed by deleteAllEntities must already be gone,
+     * removing its components or deleting it again would destroy them twice */
+    auto listener = events.addListener<std::size_t, jf::events::ComponentDestroyedEvent<jf::components::Component>>(&touched,
+        [&manager](std::size_t *count, jf::events::ComponentDestroyedEvent<jf::components::Component> event) {
+            auto entity = event.component->getEntity();
+            if (!entity.isValid())
+                return;
+            ++*count;
+            entity->removeComponent<bench::Velocity>();
+            manager.deleteEntity(entity->getID());
+        });
+    context.measure(context.getArg(), [&manager, &context]() {
+        manager.createEntities<bench::Position, bench::Velocity, bench::Tag>(context.getArg(), "bench");
+        manager.deleteAllEntities();
+    });
+    events.removeListener(listener);
+    if (touched != 0)
+        throw std::logic_error("deleteAllEntities: a component listener reached an entity being deleted");
+}
+
+BENCHMARK(getEntityByID, 10000, 100000, 1000000)
+{
+    auto &manager = jf::entities::EntityManager::getInstance();
+    bench::EntityFixture fixture(context.getArg());
+    context.measure(context.getArg(), [&manager, &fixture]() {
+        for (auto &id : fixture.getIDs())
+            bench::doNotOptimize(manager.getEntityByID(id));
+    });
+}
+
+BENCHMARK(getEntitiesByName, 10000, 100000)
+{
+    auto &manager = jf::entities::EntityManager::getInstance();
+    bench::EntityFixture fixture(context.getArg());
+    manager.createEntity("needle");
+    context.measure(1, [&manager]() {
+        bench::doNotOptimize(manager.getEntitiesByName("needle"));
+    });
+    manager.deleteEntity(manager.getEntityByName("needle")->getID());
+}
+
+BENCHMARK(createDestroyEntitiesBulk, 10000, 100000, 1000000)
+{
+    auto &manager = jf::entities::EntityManager::getInstance();
+    context.measure(context.getArg(), [&manager, &context]() {
+        manager.destroyEntities(manager.createEntities(context.getArg(), "bench"));
+    });
+}
+
+BENCHMARK(createEntitiesWithComponents, 10000, 100000)
+{
+    auto &manager = jf::entities::EntityManager::getInstance();
+    std::vector<jf::internal::ID> ids;
+    ids.reserve(context.getArg());
+    context.measure(context.getArg(), [&manager, &context, &ids]() {
+        for (std::size_t i = 0; i < context.getArg(); ++i) {
+            auto entity = manager.createEntity("bench");
+            entity->assignComponent<bench::Position>();
+            entity->assignComponent<bench::Velocity>();
+            ids.push_back(entity->getID());
+        }
+        for (auto &id : ids)
+            manager.deleteEntity(id);
+        ids.clear();
+    });
+}
+
+BENCHMARK(createEntitiesWithComponentsBulk, 10000, 100000)
+{
+    auto &manager = jf::entities::EntityManager::getInstance();
+    context.measure(context.getArg(), [&manager, &context]() {
+        manager.destroyEntities(manager.createEntities<bench::Position, bench::Velocity>(context.getArg(), "bench"));
+    });
+}
+
+BENCHMARK(instantiatePrefab, 10000, 100000)
+{
+    auto &manager = jf::entities::EntityManager::getInstance();
+    auto templateEntity = manager.createEntity("bench");
+    templateEntity->assignComponent<bench::Position>();
+    templateEntity->assignComponent<bench::Velocity>();
+    templateEntity->setEnable(false);
+    jf::entities::Prefab prefab(templateEntity);
+    context.measure(context.getArg(), [&manager, &context, &prefab]() {
+        manager.destroyEntities(manager.instantiate(prefab, context.getArg()));
+    });
+    manager.deleteEntity(templateEntity.getID());
+}
+
+BENCHMARK(createEntitiesLongName, 10000, 100000, 1000000)
+{
+    auto &manager = jf::entities::EntityManager::getInstance();
+    context.measure(context.getArg(), [&manager, &context]() {
+        manager.destroyEntities(manager.createEntities(context.getArg(), "a name too long for the small string buffer"));
+    });
+}
+
+BENCHMARK(createEntitiesUniqueNames, 10000, 100000)
+{
+    auto &manager = jf::entities::EntityManager::getInstance();
+    std::size_t level = 0;
+    context.measure(context.getArg(), [&manager, &context, &level]() {
+        for (std::size_t i = 0; i < context.getArg(); ++i)
+            manager.createEntity("enemy_" + std::to_string(level * context.getArg() + i));
+        manager.deleteAllEntities(true);
+        ++level;
+    });
+}
+
+BENCHMARK(setEnableBulk, 10000, 100000, 1000000)
+{
+    auto &manager = jf::entities::EntityManager::getInstance();
+    bench::EntityFixture fixture(context.getArg());
+    bool enabled = false;
+    context.measure(context.getArg(), [&manager, &fixture, &enabled]() {
+        manager.setEnable(fixture.getIDs(), enabled);
+        enabled = !enabled;
+    });
+}
+
+BENCHMARK(applyToEachMostlyDisabled, 10000, 100000, 1000000)
+{
+    auto &manager = jf::entities::EntityManager::getInstance();
+    bench::EntityFixture fixture(context.getArg());
+    manager.setEnable(fixture.getIDs(), false);
+    for (std::size_t i = 0; i < fixture.getIDs().size(); i += 100)
+        manager.setEnable(fixture.getIDs()[i], true);
+    context.measure(context.getArg(), [&manager]() {
+        manager.applyToEach<bench::Position>([](jf::entities::EntityHandler, jf::components::ComponentHandler<bench::Position> position) {
+            position->x += 1;
+        });
+    });
+}
@@ -0,0 +1,105 @@
+/*
+** EPITECH PROJECT, 2018
+** JFEntityComponentSystem
+** File description:
+** EventBenchmarks.cpp
+*/
+
+/* Created the 16/10/2026 at 22:31 by jfrabel */
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "Benchmark.hpp"
+#include "ECSWrapper.hpp"
+
+namespace bench {
+
+    /*!
+     * @struct BenchEvent
+     * @brief A small event
+     */
+    struct BenchEvent {
+        int value; /*!< The content of the event */
+    };
+}
+
+BENCHMARK(emitFanOut, 0, 1, 10, 100)
+{
+    auto &manager = jf::events::EventManager::getInstance();
+    std::vector<jf::internal::ID> listeners;
+    int sum = 0;
+    for (std::size_t i = 0; i < context.getArg(); ++i) {
+        listeners.push_back(manager.addListener<int, bench::BenchEvent>(&sum, [](int *total, bench::BenchEvent event) noexcept {
+            *total += event.value;
+        }));
+    }
+    context.measure(1000, [&manager]() {
+        for (int i = 0; i < 1000; ++i)
+            manager.emit<bench::BenchEvent>({i});
+    });
+    bench::doNotOptimize(sum);
+    for (auto &id : listeners)
+        manager.removeListener(id);
+}
+
+BENCHMARK(addRemoveListener, 10, 1000, 100000)
+{
+    auto &manager = jf::events::EventManager::getInstance();
+    std::vector<jf::internal::ID> listeners;
+    int sum = 0;
+    context.measure(context.getArg(), [&manager, &listeners, &sum, &context]() {
+        for (std::size_t i = 0; i < context.getArg(); ++i) {
+            listeners.push_back(manager.addListener<int, bench::BenchEvent>(&sum, [](int *total, bench::BenchEvent event) noexcept {
+                *total += event.value;
+            }));
+        }
+        for (auto &id : listeners)
+            manager.removeListener(id);
+        listeners.clear();
+    });
+}
+
+BENCHMARK(emitQueuedBatch, 1000, 100000)
+{
+    auto &manager = jf::events::EventManager::getInstance();
+    int sum = 0;
+    auto listener = manager.addBatchListener<int, bench::BenchEvent>(&sum, [](int *total, jf::events::EventSpan<bench::BenchEvent> events) noexcept {
+        for (auto &event : events)
+            *total += event.value;
+    });
+    manager.setQueued<bench::BenchEvent>();
+    context.measure(context.getArg(), [&manager, &context]() {
+        for (std::size_t i = 0; i < context.getArg(); ++i)
+            manager.emit<bench::BenchEvent>({static_cast<int>(i)});
+        manager.dispatchQueued();
+    });
+    manager.setQueued<bench::BenchEvent>(false);
+    bench::doNotOptimize(sum);
+    manager.removeListener(listener);
+}
+
+BENCHMARK(postFromThreads, 1, 8, 16)
+{
+    constexpr std::size_t eventsPerProducer = 20000;
+    auto &manager = jf::events::EventManager::getInstance();
+    std::size_t received = 0;
+    auto listener = manager.addListener<std::size_t, bench::BenchEvent>(&received, [](std::size_t *total, bench::BenchEvent) noexcept {
+        ++*total;
+    });
+    context.measure(context.getArg() * eventsPerProducer, [&manager, &context, &received]() {
+        std::size_t expected = received + context.getArg() * eventsPerProducer;
+        std::vector<std::thread> producers;
+        for (std::size_t i = 0; i < context.getArg(); ++i) {
+            producers.emplace_back([&manager]() noexcept {
+                for (std::size_t j = 0; j < eventsPerProducer; ++j)
+                    manager.post<bench::BenchEvent>({static_cast<int>(j)});
+            });
+        }
+        while (received != expected)
+            manager.dispatchQueued();
+        for (auto &producer : producers)
+            producer.join();
+    });
+    manager.removeListener(listener);
+}
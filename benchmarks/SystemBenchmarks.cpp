@@ -0,0 +1,105 @@
+/*
+** EPITECH PROJECT, 2018
+** JFEntityComponentSystem
+** File description:
+** SystemBenchmarks.cpp
+*/
+
+/* Created the 16/10/2026 at 22:31 by jfrabel */
+
+#include <utility>
+#include "Benchmark.hpp"
+#include "BenchComponents.hpp"
+
+namespace bench {
+
+    /*!
+     * @class BenchSystem
+     * @brief A system doing almost nothing, the index gives a distinct type to each system
+     * @tparam Index The index of the system
+     */
+    template<std::size_t Index>
+    class BenchSystem : public jf::systems::ISystem {
+    public:
+        void onAwake() override {}
+        void onStart() override {}
+        void onUpdate(const std::chrono::nanoseconds &elapsedTime) override
+        {
+            doNotOptimize(elapsedTime);
+        }
+        void onStop() override {}
+        void onTearDown() override {}
+    };
+
+    /*!
+     * @class ParallelBenchSystem
+     * @brief A BenchSystem declaring that it touches no component, so that all of them are updated at the same time
+     * @tparam Index The index of the system
+     */
+    template<std::size_t Index>
+    class ParallelBenchSystem : public BenchSystem<Index> {
+    public:
+        void declareAccess(jf::systems::SystemAccess &access) const override
+        {
+            access.none();
+        }
+    };
+
+    /*!
+     * @brief Add and start the first systems
+     * @tparam System The template of the systems
+     * @tparam Indexes The indexes of all the systems that can be added
+     * @param count The number of systems to add
+     */
+    template<template<std::size_t> class System, std::size_t... Indexes>
+    void addSystems(std::size_t count, std::index_sequence<Indexes...>)
+    {
+        auto &manager = jf::systems::SystemManager::getInstance();
+        (void)std::initializer_list<int>{(Indexes < count ? (manager.addSystem<System<Indexes>>(), manager.startSystem<System<Indexes>>(), 0) : 0)...};
+    }
+
+    /*!
+     * @brief Stop and remove the first systems
+     * @tparam System The template of the systems
+     * @tparam Indexes The indexes of all the systems that can be added
+     * @param count The number of systems to remove
+     */
+    template<template<std::size_t> class System, std::size_t... Indexes>
+    void removeSystems(std::size_t count, std::index_sequence<Indexes...>)
+    {
+        auto &manager = jf::systems::SystemManager::getInstance();
+        (void)std::initializer_list<int>{(Indexes < count ? (manager.stopSystem<System<Indexes>>(), 0) : 0)...};
+        manager.tick();
+        (void)std::initializer_list<int>{(Indexes < count ? (manager.removeSystem<System<Indexes>>(), 0) : 0)...};
+        manager.tick();
+    }
+}
+
+BENCHMARK(tickSystems, 1, 16, 64, 128)
+{
+    auto &manager = jf::systems::SystemManager::getInstance();
+    bench::addSystems<bench::BenchSystem>(context.getArg(), std::make_index_sequence<128>());
+    manager.tick();
+    manager.tick();
+    context.measure(1, [&manager]() {
+        manager.tick();
+    });
+    bench::removeSystems<bench::BenchSystem>(context.getArg(), std::make_index_sequence<128>());
+}
+
+BENCHMARK(tickAfterThreadCountChange, 2, 4, 8)
+{
+    auto &manager = jf::systems::SystemManager::getInstance();
+    auto &pool = jf::ThreadPool::getInstance();
+    std::size_t threadCount = pool.getThreadCount();
+    bench::addSystems<bench::ParallelBenchSystem>(16, std::make_index_sequence<16>());
+    manager.tick();
+    manager.tick();
+    context.measure(1, [&manager, &pool, &context]() {
+        pool.setThreadCount(context.getArg());
+        for (int i = 0; i < 5; ++i)
+            manager.tick();
+    });
+    pool.setThreadCount(threadCount);
+    bench::removeSystems<bench::ParallelBenchSystem>(16, std::make_index_sequence<16>());
+}
@@ -0,0 +1,36 @@
+/*
+** EPITECH PROJECT, 2018
+** JFEntityComponentSystem
+** File description:
+** main.cpp
+*/
+
+/* Created the 16/10/2026 at 22:31 by jfrabel */
+
+#include <cstdlib>
+#include <new>
+#include "Benchmark.hpp"
+
+void *operator new(std::size_t size)
+{
+    bench::allocations.fetch_add(1, std::memory_order_relaxed);
+    void *memory = std::malloc(size == 0 ? 1 : size);
+    if (memory == nullptr)
+        throw std::bad_alloc();
+    return memory;
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+int main(int ac, char **av)
+{
+    return bench::run(ac, av);
+}
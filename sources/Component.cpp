@@ -7,14 +7,35 @@
 
 /* Created the 24/03/2019 at 17:28 by jfrabel */
 
+#include <type_traits>
 #include "Component.hpp"
+#include "ComponentStorage.hpp"
 #include "Events.hpp"
 #include "EventManager.hpp"
 
+static_assert(std::is_trivially_copyable<jf::components::ComponentHandler<jf::components::Component>>::value,
+    "ComponentHandler should be trivially copyable");
+
 jf::components::Component::Component(jf::entities::Entity &entity)
-    : _entity(entity)
+    : _entity(entity), _version(BaseComponentStorage::constructingVersion())
+{
+    BaseComponentStorage::constructingVersion() = nullptr;
+    if (BaseComponentStorage::mutedEvents())
+        BaseComponentStorage::mutedEvents() = false;
+    else
+        EMIT_CREATE(Component);
+}
+
+jf::components::Component::Component(const jf::components::Component &other)
+    : _entity(BaseComponentStorage::constructingEntity() != nullptr ? *BaseComponentStorage::constructingEntity() : other._entity),
+    _version(BaseComponentStorage::constructingVersion())
 {
-    EMIT_CREATE(Component);
+    BaseComponentStorage::constructingVersion() = nullptr;
+    BaseComponentStorage::constructingEntity() = nullptr;
+    if (BaseComponentStorage::mutedEvents())
+        BaseComponentStorage::mutedEvents() = false;
+    else
+        EMIT_CREATE(Component);
 }
 
 jf::entities::EntityHandler jf::components::Component::getEntity()
@@ -22,7 +43,13 @@ jf::entities::EntityHandler jf::components::Component::getEntity()
     return jf::entities::EntityHandler(&_entity);
 }
 
+const uint32_t *jf::components::Component::getVersion() const
+{
+    return _version;
+}
+
 jf::components::Component::~Component()
 {
-    EMIT_DELETE(Component);
+    if (!BaseComponentStorage::mutedEvents())
+        EMIT_DELETE(Component);
 }
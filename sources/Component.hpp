@@ -50,14 +50,30 @@ namespace jf {
              * @param entity The entity this component will sit on
              */
             explicit Component(entities::Entity &entity);
+            /*!
+             * @brief cpy ctor
+             * @param other The component to copy
+             *
+             * When the copy is made by a storage (prefab instantiation) it sits on the entity it is copied for,
+             * otherwise it sits on the same entity as other
+             */
+            Component(const Component &other);
             /*!
              * @brief Method used to retreive the entity this component is sitting on
              * @return A EntityHandler to the entity this component is sitting on
              */
             entities::EntityHandler getEntity();
 
+            /*!
+             * @brief Method used internally by ComponentHandler to know if this component still exists
+             * @return A pointer to the version of the storage slot of this component
+             * (nullptr if the component was not created by a ComponentStorage)
+             */
+            const uint32_t *getVersion() const;
+
         private:
             entities::Entity &_entity; /*!< The entity this component is linked to */
+            const uint32_t *_version; /*!< The version of the storage slot of this component */
         };
     }
 }
@@ -10,9 +10,8 @@
 #ifndef JFENTITYCOMPONENTSYSTEM_COMPONENTHANDLER_HPP
 #define JFENTITYCOMPONENTSYSTEM_COMPONENTHANDLER_HPP
 
-#include "ID.hpp"
-#include "ComponentDestroyedEvent.hpp"
-#include "EventManager.hpp"
+#include <cstdint>
+#include "Exceptions.hpp"
 
 /*!
  * @namespace jf
@@ -33,6 +32,11 @@ namespace jf {
          *
          * A handler can be valid or invalid.
          * An invalid handler is a handler that manages no component or a destroyed component.
+         *
+         * A handler is a pointer to a component and the version of the storage slot of the component
+         * when the handler was created. Destroying a component increments the version of its slot
+         * so a handler is valid as long as both versions match.
+         * Handlers are trivially copyable and do not register anything so they can be created and copied freely.
          */
         template<typename T>
         class ComponentHandler {
@@ -40,50 +44,16 @@ namespace jf {
             /*!
              * @brief default ctor, will create an invalid ComponentHandler
              */
-            ComponentHandler(): _ptr(nullptr), _eventListenerID()
-            {
-                _eventListenerID = events::EventManager::getInstance().addListener<ComponentHandler<Component>, events::ComponentDestroyedEvent<Component>>(
-                    reinterpret_cast<ComponentHandler<Component>*>(this),
-                    [](ComponentHandler<Component> *data, events::ComponentDestroyedEvent<Component> event) {
-                        if (event.component == data->get())
-                            data->set(nullptr);
-                    });
-            }
+            ComponentHandler(): _ptr(nullptr), _version(nullptr), _expectedVersion(0)
+            {}
 
             /*!
              * @brief ctor
              * @param component The handeled component
              */
-            explicit ComponentHandler(T *component): _ptr(component), _eventListenerID()
-            {
-                _eventListenerID = events::EventManager::getInstance().addListener<ComponentHandler<Component>, events::ComponentDestroyedEvent<Component>>(
-                    reinterpret_cast<ComponentHandler<Component>*>(this),
-                    [](ComponentHandler<Component> *data, events::ComponentDestroyedEvent<Component> event) {
-                        if (event.component == data->get())
-                            data->set(nullptr);
-                    });
-            }
-
-            /*!
-             * @brief cpy ctor
-             * @param other The ComponentHandler to copy
-             */
-            ComponentHandler(const ComponentHandler<T> &other): _ptr(other._ptr), _eventListenerID()
-            {
-                _eventListenerID = events::EventManager::getInstance().addListener<ComponentHandler<Component>, events::ComponentDestroyedEvent<Component>>(
-                    reinterpret_cast<ComponentHandler<Component>*>(this),
-                    [](ComponentHandler<Component> *data, events::ComponentDestroyedEvent<Component> event) {
-                        if (event.component == data->get())
-                            data->set(nullptr);
-                    });
-            }
-
-            /*!
-             * @brief dtor
-             */
-            virtual ~ComponentHandler()
+            explicit ComponentHandler(T *component): _ptr(nullptr), _version(nullptr), _expectedVersion(0)
             {
-                events::EventManager::getInstance().removeListener(_eventListenerID);
+                set(component);
             }
 
         public:
@@ -92,7 +62,7 @@ namespace jf {
              * @return A reference on the managed component
              * @throw jf::BadHandlerException if this handler is invalid (destroyed component, uninitialized handler)
              */
-            virtual T &operator*()
+            T &operator*()
             {
                 if (!isValid())
                     throw jf::BadHandlerException("Invalid ComponentHandler", "ComponentHandler");
@@ -104,7 +74,7 @@ namespace jf {
              * @return A const reference on the managed component
              * @throw jf::BadHandlerException if this handler is invalid (destroyed component, uninitialized handler)
              */
-            virtual const T &operator*() const
+            const T &operator*() const
             {
                 if (!isValid())
                     throw jf::BadHandlerException("Invalid ComponentHandler", "ComponentHandler");
@@ -116,7 +86,7 @@ namespace jf {
              * @return A pointer to the managed component
              * @throw jf::BadHandlerException if this handler is invalid (destroyed component, uninitialized handler)
              */
-            virtual T *operator->()
+            T *operator->()
             {
                 if (!isValid())
                     throw jf::BadHandlerException("Invalid ComponentHandler", "ComponentHandler");
@@ -128,7 +98,7 @@ namespace jf {
              * @return A const pointer to the managed component
              * @throw jf::BadHandlerException if this handler is invalid (destroyed component, uninitialized handler)
              */
-            virtual const T *operator->() const
+            const T *operator->() const
             {
                 if (!isValid())
                     throw jf::BadHandlerException("Invalid ComponentHandler", "ComponentHandler");
@@ -140,7 +110,7 @@ namespace jf {
              * @param rhs The ComponentHandler to compare to
              * @return true if the two handler manage the same component false otherwise (return true if both invalid)
              */
-            virtual bool operator==(const ComponentHandler<T> &rhs) const
+            bool operator==(const ComponentHandler<T> &rhs) const
             {
                 if (!isValid() && !rhs.isValid())
                     return true;
@@ -149,46 +119,45 @@ namespace jf {
                 return _ptr == rhs._ptr;
             }
 
-            ComponentHandler<T> &operator=(const ComponentHandler<T> &other)
-            {
-                if (&other == this)
-                    return *this;
-                _ptr = other._ptr;
-                return *this;
-            }
-
         public:
             /*!
              * @brief Method to know if the handler is valid or not
              * @return true if the handler is valid false otherwise
+             *
+             * A component that was not created by a ComponentStorage has no version,
+             * its handlers are valid as long as they are not set to nullptr.
              */
-            virtual bool isValid() const
+            bool isValid() const
             {
-                return _ptr != nullptr;
+                return _ptr != nullptr && (_version == nullptr || *_version == _expectedVersion);
             }
 
             /*!
              * @brief An alternative method to get the managed component without a throw
-             * @return The managed pointer
+             * @return The managed pointer, nullptr if the handler is invalid
              *
              * DO NOT store component manually. Always use a handler.
              */
-            virtual T *get()
+            T *get() const
             {
-                return _ptr;
+                return isValid() ? _ptr : nullptr;
             }
 
             /*!
              * @brief A method to set the managed component.
+             * @param component The component to manage
              */
-            virtual void set(T *component)
+            void set(T *component)
             {
                 _ptr = component;
+                _version = component != nullptr ? component->getVersion() : nullptr;
+                _expectedVersion = _version != nullptr ? *_version : 0;
             }
 
         private:
-            T *_ptr; /*!< A pointer to the handeled component, will be null if handler is invalid */
-            internal::ID _eventListenerID; /*!< The id of the event invalidating this handler on component destruction*/
+            T *_ptr; /*!< A pointer to the handeled component, nullptr if the handler manages nothing */
+            const uint32_t *_version; /*!< The version of the storage slot of the component */
+            uint32_t _expectedVersion; /*!< The version of the slot when the handler was set */
         };
     }
 }
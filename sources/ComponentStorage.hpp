@@ -0,0 +1,805 @@
+/*
+** EPITECH PROJECT, 2018
+** JFEntityComponentSystem
+** File description:
+** ComponentStorage.hpp
+*/
+
+/* Created the 16/10/2026 at 10:02 by jfrabel */
+
+#ifndef JFENTITYCOMPONENTSYSTEM_COMPONENTSTORAGE_HPP
+#define JFENTITYCOMPONENTSYSTEM_COMPONENTSTORAGE_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <typeindex>
+#include <vector>
+#include "ID.hpp"
+#include "Exceptions.hpp"
+#include "Signature.hpp"
+#include "DynamicBitset.hpp"
+#include "Entity.hpp"
+#include "Component.hpp"
+#include "EventManager.hpp"
+#include "ComponentCreatedEvent.hpp"
+
+#define SPARSE_SET_STORAGE(T) namespace jf { namespace components { template<> struct UseSparseSet<T> : std::true_type {}; } }
+#define NO_LIFECYCLE_EVENTS(T) namespace jf { namespace components { template<> struct LifecycleEvents<T> : std::false_type {}; } }
+
+/*!
+ * @namespace jf
+ * @brief The jfecs library namespace
+ */
+namespace jf {
+
+    /*!
+     * @namespace jf::components
+     * @brief The namespace containing the components
+     */
+    namespace components {
+
+        /*!
+         * @struct UseSparseSet
+         * @brief A trait telling if the storage of a component type keeps a sparse set index
+         * @tparam T The type of component
+         *
+         * Use the macro SPARSE_SET_STORAGE(type_of_your_component) in the global namespace to enable it.
+         * getComponent, hasComponent and removeComponent will then be array lookups instead of hash lookups.
+         */
+        template<typename T>
+        struct UseSparseSet : std::false_type {};
+
+        /*!
+         * @struct LifecycleEvents
+         * @brief A trait telling if the components of a type emit creation and deletion events
+         * @tparam T The type of component
+         *
+         * Use the macro NO_LIFECYCLE_EVENTS(type_of_your_component) in the global namespace,
+         * after declaring the type and before using it, to disable them.
+         * The components of this type will then neither emit ComponentCreatedEvent<Component> and ComponentDestroyedEvent<Component>
+         * (when created with assignComponent) nor their own events through EMIT_CREATE and EMIT_DELETE.
+         * Useful for short lived components created in large numbers (particles, projectiles...).
+         */
+        template<typename T>
+        struct LifecycleEvents : std::true_type {};
+
+        /*!
+         * @struct StorageStats
+         * @brief The memory usage of a ComponentStorage
+         */
+        struct StorageStats {
+            std::size_t live; /*!< The number of living components */
+            std::size_t free; /*!< The number of allocated slots not used by a component */
+            std::size_t chunks; /*!< The number of allocated chunks */
+            std::size_t bytes; /*!< The memory used by the slots of all the chunks and their versions */
+        };
+
+        /*!
+         * @class BaseComponentStorage
+         * @brief A class used internaly to destroy components without knowing their types
+         */
+        class BaseComponentStorage {
+        public:
+            /*!
+             * @brief dtor
+             */
+            virtual ~BaseComponentStorage() = default;
+
+            /*!
+             * @brief Destroy a component previously created by this storage
+             * @param component The component to destroy
+             */
+            virtual void destroy(Component *component) = 0;
+
+            /*!
+             * @brief Get the number of components living in this storage
+             * @return The number of living components
+             */
+            virtual std::size_t size() const = 0;
+
+            /*!
+             * @brief Get the memory usage of this storage
+             * @return The stats of the storage
+             */
+            virtual StorageStats getStats() const = 0;
+
+            /*!
+             * @brief Allocate slots ahead so that the given number of components can live without any allocation
+             * @param count The number of components
+             */
+            virtual void reserve(std::size_t count) = 0;
+
+            /*!
+             * @brief Free the chunks that hold no living component
+             */
+            virtual void shrink() = 0;
+
+            /*!
+             * @brief Destroy, in memory order, the components of a set of entities
+             * @param owners The ids of the entities whose components are destroyed
+             * @return The number of destroyed components
+             *
+             * Used internally by EntityManager::deleteAllEntities, the entities must already have forgotten their components
+             */
+            virtual std::size_t destroyOwnedBy(const internal::DynamicBitset &owners) = 0;
+
+            /*!
+             * @brief Get if the components of this storage can be copied by clone
+             * @return true if the type of component has a copy constructor
+             */
+            virtual bool isCopyable() const = 0;
+
+            /*!
+             * @brief Get the dense id of the type of the components of this storage
+             * @return The index of the bit of the type in the entity signatures
+             */
+            virtual std::size_t getTypeID() const = 0;
+
+            /*!
+             * @brief Construct in this storage a copy of a component of this storage for each of several entities and attach it
+             * @param source The component to copy
+             * @param entities The entities the copies will sit on
+             * @param type The type of the component, the entities must not already have a component of this type
+             * @throw ComponentNotCopyableException if the type of component has no copy constructor
+             *
+             * The copies are contiguous in memory: they take the next free slots if those follow each other,
+             * otherwise a new chunk of at least entities.size() slots
+             */
+            virtual void cloneN(const Component &source, const std::vector<entities::Entity *> &entities, const std::type_index &type) = 0;
+
+            /*!
+             * @brief Get the version of the slot of the component being constructed on this thread
+             * @return A reference to the pointer on the version, nullptr if no component is being constructed
+             *
+             * Used internally by the Component constructor to know the version of its slot
+             */
+            static const uint32_t *&constructingVersion()
+            {
+                static thread_local const uint32_t *version = nullptr;
+                return version;
+            }
+
+            /*!
+             * @brief Get the entity of the component being copied on this thread
+             * @return A reference to the pointer on the entity, nullptr if no component is being copied by a storage
+             *
+             * Used internally by the Component copy constructor to sit the copy on its new entity
+             */
+            static entities::Entity *&constructingEntity()
+            {
+                static thread_local entities::Entity *entity = nullptr;
+                return entity;
+            }
+
+            /*!
+             * @brief Get if the component being constructed or destroyed on this thread must not emit lifecycle events
+             * @return A reference to the flag of the current thread
+             *
+             * Used internally by the Component constructor and destructor, see LifecycleEvents
+             */
+            static bool &mutedEvents()
+            {
+                static thread_local bool muted = false;
+                return muted;
+            }
+
+            /*!
+             * @brief Get all the storages created so far
+             * @return The storages in creation order
+             */
+            static std::vector<BaseComponentStorage *> getStorages()
+            {
+                std::lock_guard<std::mutex> lock(storagesMutex());
+                return storages();
+            }
+
+        protected:
+            /*!
+             * @brief Add a storage to the list returned by getStorages
+             * @param storage The new storage
+             */
+            static void registerStorage(BaseComponentStorage *storage)
+            {
+                std::lock_guard<std::mutex> lock(storagesMutex());
+                storages().push_back(storage);
+            }
+
+        private:
+            /*!
+             * @brief Get the list of the storages, never destroyed like the storages themselves
+             * @return A reference to the list
+             */
+            static std::vector<BaseComponentStorage *> &storages()
+            {
+                static std::vector<BaseComponentStorage *> *list = new std::vector<BaseComponentStorage *>();
+                return *list;
+            }
+
+            /*!
+             * @brief Get the mutex protecting the list of the storages (storages may be created concurrently)
+             * @return A reference to the mutex
+             */
+            static std::mutex &storagesMutex()
+            {
+                static std::mutex *mutex = new std::mutex();
+                return *mutex;
+            }
+        };
+
+        /*!
+         * @class ComponentStorage
+         * @brief A class storing all the components of a given type in contiguous chunks
+         * @tparam C The type of stored component
+         *
+         * Components are constructed in place inside chunks so that iterating over a component type
+         * walks linearly through memory. A component never moves once created
+         * and the slot is reused by a later component once the component is destroyed.
+         * Creating and destroying components only allocates memory when all the slots are used and a new chunk is needed,
+         * the size of the new chunks can be changed with setChunkSize and slots can be allocated ahead with reserve.
+         *
+         * Each slot has a version incremented when its component is destroyed.
+         * ComponentHandlers keep the version of the slot when they are created to know if their component still exists.
+         * Versions are allocated apart from the components so they stay readable as long as the program runs.
+         *
+         * If UseSparseSet<C> is true the storage also keeps a dense array of its components and their entities
+         * and a sparse array giving for an entity id the position in the dense arrays.
+         */
+        template<typename C>
+        class ComponentStorage final : public BaseComponentStorage {
+        public:
+            static constexpr std::size_t defaultChunkSize = 256; /*!< The default number of components in a chunk */
+
+        public:
+            /*!
+             * @brief cpy ctor
+             * @param other The storage to copy
+             */
+            ComponentStorage(const ComponentStorage<C> &other) = delete;
+
+            /*!
+             * @brief dtor
+             */
+            ~ComponentStorage() override = default;
+
+            /*!
+             * @brief A static method used to retrieve the storage of this component type
+             * @return A reference to the instance
+             *
+             * The storage is never destroyed as entities (and so their components)
+             * can still be destroyed by others singletons after the end of main
+             */
+            static ComponentStorage<C> &getInstance()
+            {
+                static ComponentStorage<C> *instance = new ComponentStorage<C>();
+                return *instance;
+            }
+
+        private:
+            /*!
+             * @brief ctor
+             */
+            ComponentStorage()
+                : _chunkSize(defaultChunkSize), _chunks(), _versions(), _freeVersions(), _freeSlots(), _size(0), _sparse(), _dense(), _denseEntities(),
+                _iterating(0), _tombstones(0)
+            {
+                registerStorage(this);
+            }
+
+        public:
+            /*!
+             * @brief Assignment operator
+             * @param other The storage to assign to
+             * @return The current instance
+             */
+            ComponentStorage<C> &operator=(const ComponentStorage<C> &other) = delete;
+
+        public:
+            /*!
+             * @brief Construct a new component in the storage
+             * @tparam Params The types of parameters given to the constructor of the component
+             * @param entity The entity the component will sit on
+             * @param entityID The id of the entity the component will sit on
+             * @param params The parameters given to the constructor of the component
+             * @return A pointer to the newly created component
+             */
+            template<typename ...Params>
+            C *create(entities::Entity &entity, const internal::ID &entityID, Params ...params)
+            {
+                return construct(entity, entityID, [&entity, &params...](void *memory) {
+                    return new (memory) C(entity, params...);
+                });
+            }
+
+            /*!
+             * @brief Get if the components of this storage can be copied by clone
+             * @return true if C has a copy constructor
+             */
+            bool isCopyable() const override
+            {
+                return std::is_copy_constructible<C>::value;
+            }
+
+            /*!
+             * @brief Get the dense id of C
+             * @return The index of the bit of C in the entity signatures
+             */
+            std::size_t getTypeID() const override
+            {
+                return getComponentTypeID<C>();
+            }
+
+            /*!
+             * @brief Construct in this storage a copy of a component of this storage for each of several entities and attach it
+             * @param source The component to copy
+             * @param entities The entities the copies will sit on
+             * @param type The type of the component, the entities must not already have a component of this type
+             * @throw ComponentNotCopyableException if C has no copy constructor
+             *
+             * The slots of all the copies are allocated at once so the copies are contiguous in memory.
+             * Each copy emits ComponentCreatedEvent<C> like a component built by Entity::assignComponent.
+             */
+            void cloneN(const Component &source, const std::vector<entities::Entity *> &entities, const std::type_index &type) override
+            {
+                cloneN(static_cast<const C &>(source), entities, type, std::is_copy_constructible<C>());
+            }
+
+            /*!
+             * @brief Destroy a component created by this storage
+             * @param component The component to destroy
+             */
+            void destroy(Component *component) override
+            {
+                C *typed = static_cast<C *>(component);
+                Slot *slot = reinterpret_cast<Slot *>(typed);
+                if (UseSparseSet<C>::value)
+                    unlink(slot);
+                slot->owner = nullptr;
+                ++*slot->version;
+                bool muted = mutedEvents();
+                mutedEvents() = !LifecycleEvents<C>::value;
+                typed->~C();
+                mutedEvents() = muted;
+                _freeSlots.push_back(slot);
+                --_size;
+            }
+
+            /*!
+             * @brief Get the component of an entity using the sparse set index
+             * @param entityID The id of the entity
+             * @return The component of the entity or nullptr if the entity has no component of this type
+             *
+             * Will always return nullptr if UseSparseSet<C> is false
+             */
+            C *get(const internal::ID &entityID) const
+            {
+                uint64_t index = entityID.getID();
+                if (index >= _sparse.size() || _sparse[index] == npos)
+                    return nullptr;
+                return _dense[_sparse[index]];
+            }
+
+            /*!
+             * @brief Apply a function to every living component in memory order
+             * @tparam Func The type of the callable (void(entities::Entity &, C &))
+             * @param func The function to apply
+             *
+             * Components created during the iteration may or may not be visited.
+             * Components destroyed during the iteration will not be visited.
+             * For sparse set storages the dense arrays are walked instead of the chunks.
+             */
+            template<typename Func>
+            void forEach(Func func)
+            {
+                ++_iterating;
+                try {
+                    if (UseSparseSet<C>::value) {
+                        for (std::size_t i = 0; i < _dense.size(); ++i) {
+                            if (_dense[i] != nullptr)
+                                func(*_denseEntities[i], *_dense[i]);
+                        }
+                    } else {
+                        for (std::size_t i = 0; i < _chunks.size(); ++i) {
+                            Slot *chunk = _chunks[i].slots.get();
+                            std::size_t chunkSize = _chunks[i].size;
+                            for (std::size_t j = 0; j < chunkSize; ++j) {
+                                if (chunk[j].owner != nullptr)
+                                    func(*chunk[j].owner, *reinterpret_cast<C *>(&chunk[j].data));
+                            }
+                        }
+                    }
+                } catch (...) {
+                    endIteration();
+                    throw;
+                }
+                endIteration();
+            }
+
+            /*!
+             * @brief Get the number of components living in this storage
+             * @return The number of living components
+             */
+            std::size_t size() const override
+            {
+                return _size;
+            }
+
+            /*!
+             * @brief Get the memory usage of this storage
+             * @return The stats of the storage
+             */
+            StorageStats getStats() const override
+            {
+                std::size_t slots = _size + _freeSlots.size();
+                return {_size, _freeSlots.size(), _chunks.size(), slots * (sizeof(Slot) + sizeof(uint32_t))};
+            }
+
+            /*!
+             * @brief Get the number of components in the chunks allocated from now on
+             * @return The size of the next chunks
+             */
+            std::size_t getChunkSize() const
+            {
+                return _chunkSize;
+            }
+
+            /*!
+             * @brief Set the number of components in the chunks allocated from now on
+             * @param chunkSize The size of the next chunks (at least 1)
+             *
+             * Bigger chunks mean less allocations and longer linear walks, smaller chunks less unused memory
+             */
+            void setChunkSize(std::size_t chunkSize)
+            {
+                _chunkSize = chunkSize == 0 ? 1 : chunkSize;
+            }
+
+            /*!
+             * @brief Allocate slots ahead so that the given number of components can live without any allocation
+             * @param count The number of components
+             *
+             * The missing slots are allocated in a single chunk
+             */
+            void reserve(std::size_t count) override
+            {
+                std::size_t capacity = _size + _freeSlots.size();
+                if (count > capacity)
+                    addChunk(count - capacity);
+            }
+
+            /*!
+             * @brief Free the chunks that hold no living component
+             *
+             * The versions of the freed slots keep their value and are reused by the next chunks,
+             * so handlers on the old components stay invalid and the versions do not grow with each shrink.
+             * Does nothing while the storage is being iterated, the chunks are then kept until the next call.
+             */
+            void shrink() override
+            {
+                if (_iterating != 0)
+                    return;
+                std::size_t kept = 0;
+                for (std::size_t i = 0; i < _chunks.size(); ++i) {
+                    Slot *chunk = _chunks[i].slots.get();
+                    std::size_t chunkSize = _chunks[i].size;
+                    bool used = false;
+                    for (std::size_t j = 0; j < chunkSize && !used; ++j)
+                        used = chunk[j].owner != nullptr;
+                    if (used)
+                        _chunks[kept++] = std::move(_chunks[i]);
+                    else
+                        recycleVersions(_chunks[i]);
+                }
+                _chunks.resize(kept);
+                _chunks.shrink_to_fit();
+                _freeSlots.clear();
+                for (std::size_t i = _chunks.size(); i > 0; --i) {
+                    Slot *chunk = _chunks[i - 1].slots.get();
+                    for (std::size_t j = _chunks[i - 1].size; j > 0; --j) {
+                        if (chunk[j - 1].owner == nullptr)
+                            _freeSlots.push_back(&chunk[j - 1]);
+                    }
+                }
+                _freeSlots.shrink_to_fit();
+                if (_size == 0) {
+                    std::vector<std::size_t>().swap(_sparse);
+                    std::vector<C *>().swap(_dense);
+                    std::vector<entities::Entity *>().swap(_denseEntities);
+                }
+            }
+
+            /*!
+             * @brief Destroy, in memory order, the components of a set of entities
+             * @param owners The ids of the entities whose components are destroyed
+             * @return The number of destroyed components
+             *
+             * Used internally by EntityManager::deleteAllEntities, the entities must already have forgotten their components
+             */
+            std::size_t destroyOwnedBy(const internal::DynamicBitset &owners) override
+            {
+                std::size_t destroyed = 0;
+                for (std::size_t i = 0; i < _chunks.size() && _size != 0; ++i) {
+                    Slot *chunk = _chunks[i].slots.get();
+                    std::size_t chunkSize = _chunks[i].size;
+                    for (std::size_t j = 0; j < chunkSize; ++j) {
+                        if (chunk[j].owner != nullptr && owners.test(chunk[j].ownerID)) {
+                            destroy(reinterpret_cast<C *>(&chunk[j].data));
+                            ++destroyed;
+                        }
+                    }
+                }
+                return destroyed;
+            }
+
+        private:
+            /*!
+             * @brief Construct a new component in a free slot
+             * @tparam Func The type of the callable (C *(void *))
+             * @param entity The entity the component will sit on
+             * @param entityID The id of the entity the component will sit on
+             * @param func The function constructing the component in the given memory
+             * @return A pointer to the newly created component
+             */
+            template<typename Func>
+            C *construct(entities::Entity &entity, const internal::ID &entityID, Func func)
+            {
+                if (_freeSlots.empty())
+                    addChunk(_chunkSize);
+                Slot *slot = _freeSlots.back();
+                _freeSlots.pop_back();
+                C *component;
+                constructingVersion() = slot->version;
+                constructingEntity() = &entity;
+                bool muted = mutedEvents();
+                mutedEvents() = !LifecycleEvents<C>::value;
+                try {
+                    component = func(&slot->data);
+                } catch (...) {
+                    constructingVersion() = nullptr;
+                    constructingEntity() = nullptr;
+                    mutedEvents() = muted;
+                    _freeSlots.push_back(slot);
+                    throw;
+                }
+                constructingVersion() = nullptr;
+                constructingEntity() = nullptr;
+                mutedEvents() = muted;
+                slot->owner = &entity;
+                slot->ownerID = entityID.getID();
+                ++_size;
+                if (UseSparseSet<C>::value)
+                    link(slot);
+                return component;
+            }
+
+            /*!
+             * @brief Copy a component for each entity using its copy constructor
+             * @tparam EntityType entities::Entity, deduced so that the entities are used once the class is complete
+             * @param source The component to copy
+             * @param entities The entities the copies will sit on
+             * @param type The type of the component
+             */
+            template<typename EntityType>
+            void cloneN(const C &source, const std::vector<EntityType *> &entities, const std::type_index &type, std::true_type)
+            {
+                if (!hasContiguousFreeSlots(entities.size()))
+                    addChunk(std::max(entities.size(), _chunkSize));
+                auto &eventManager = events::EventManager::getInstance();
+                bool notify = LifecycleEvents<C>::value && eventManager.hasListeners<events::ComponentCreatedEvent<C>>();
+                for (auto *entity : entities) {
+                    C *copy = construct(*entity, entity->getID(), [&source](void *memory) {
+                        return new (memory) C(source);
+                    });
+                    entity->attachComponent(type, copy, this);
+                    if (notify)
+                        eventManager.emit<events::ComponentCreatedEvent<C>>({ComponentHandler<C>(copy)});
+                }
+            }
+
+            /*!
+             * @brief Fail to copy a component without copy constructor
+             * @throw ComponentNotCopyableException always
+             */
+            void cloneN(const C &, const std::vector<entities::Entity *> &, const std::type_index &, std::false_type)
+            {
+                throw ComponentNotCopyableException("This type of component has no copy constructor", "cloneN");
+            }
+
+            /*!
+             * @struct Slot
+             * @brief The memory of a single component
+             */
+            struct Slot {
+                typename std::aligned_storage<sizeof(C), alignof(C)>::type data; /*!< The memory of the component */
+                entities::Entity *owner = nullptr; /*!< The entity of the component, nullptr if the slot is free */
+                uint64_t ownerID = 0; /*!< The id of the entity of the component */
+                std::size_t position = 0; /*!< The position of the component in the dense arrays (sparse set only) */
+                uint32_t *version = nullptr; /*!< The version of the slot */
+            };
+
+            /*!
+             * @struct Chunk
+             * @brief Slots allocated at once
+             */
+            struct Chunk {
+                std::unique_ptr<Slot[]> slots; /*!< The slots of the chunk */
+                std::size_t size; /*!< The number of slots of the chunk */
+            };
+
+            /*!
+             * @brief Allocate a new chunk and make its slots available
+             * @param chunkSize The number of slots of the chunk
+             */
+            void addChunk(std::size_t chunkSize)
+            {
+                _freeSlots.reserve(_freeSlots.size() + chunkSize);
+                _chunks.push_back({std::unique_ptr<Slot[]>(new Slot[chunkSize]), chunkSize});
+                Slot *chunk = _chunks.back().slots.get();
+                std::size_t assigned = 0;
+                while (assigned < chunkSize && !_freeVersions.empty()) {
+                    auto &range = _freeVersions.back();
+                    std::size_t taken = std::min(range.second, chunkSize - assigned);
+                    for (std::size_t i = 0; i < taken; ++i)
+                        chunk[assigned + i].version = range.first + i;
+                    range.first += taken;
+                    range.second -= taken;
+                    if (range.second == 0)
+                        _freeVersions.pop_back();
+                    assigned += taken;
+                }
+                if (assigned < chunkSize) {
+                    _versions.emplace_back(new uint32_t[chunkSize - assigned]());
+                    uint32_t *versions = _versions.back().get();
+                    for (std::size_t i = assigned; i < chunkSize; ++i)
+                        chunk[i].version = &versions[i - assigned];
+                }
+                for (std::size_t i = chunkSize; i > 0; --i)
+                    _freeSlots.push_back(&chunk[i - 1]);
+            }
+
+            /*!
+             * @brief Get if the next free slots follow each other in memory
+             * @param count The number of slots
+             * @return true if the next count slots given by construct are contiguous
+             *
+             * The slots of a new chunk are given in memory order, recycled slots are given first
+             */
+            bool hasContiguousFreeSlots(std::size_t count) const
+            {
+                if (count > _freeSlots.size())
+                    return false;
+                std::size_t last = _freeSlots.size() - 1;
+                auto first = reinterpret_cast<std::uintptr_t>(_freeSlots[last]);
+                for (std::size_t i = 1; i < count; ++i) {
+                    if (reinterpret_cast<std::uintptr_t>(_freeSlots[last - i]) != first + i * sizeof(Slot))
+                        return false;
+                }
+                return true;
+            }
+
+            /*!
+             * @brief Give the versions of the slots of a chunk about to be freed to the next chunks
+             * @param chunk The chunk
+             *
+             * The versions keep their value so that handlers on the old components stay invalid
+             */
+            void recycleVersions(const Chunk &chunk)
+            {
+                for (std::size_t i = 0; i < chunk.size; ++i) {
+                    uint32_t *version = chunk.slots[i].version;
+                    if (!_freeVersions.empty() && _freeVersions.back().first + _freeVersions.back().second == version)
+                        ++_freeVersions.back().second;
+                    else
+                        _freeVersions.emplace_back(version, 1);
+                }
+            }
+
+            /*!
+             * @brief Add a component to the sparse set index
+             * @param slot The slot of the component
+             */
+            void link(Slot *slot)
+            {
+                if (slot->ownerID >= _sparse.size())
+                    _sparse.resize(slot->ownerID + 1, npos);
+                slot->position = _dense.size();
+                _sparse[slot->ownerID] = slot->position;
+                _dense.push_back(reinterpret_cast<C *>(&slot->data));
+                _denseEntities.push_back(slot->owner);
+            }
+
+            /*!
+             * @brief Remove a component from the sparse set index
+             * @param slot The slot of the component
+             *
+             * The last element of the dense arrays is moved in place of the removed one.
+             * During an iteration the element is only marked as removed and the arrays are packed afterward.
+             */
+            void unlink(Slot *slot)
+            {
+                std::size_t position = slot->position;
+                if (_sparse[slot->ownerID] == position)
+                    _sparse[slot->ownerID] = npos;
+                if (_iterating != 0) {
+                    _dense[position] = nullptr;
+                    ++_tombstones;
+                    return;
+                }
+                std::size_t last = _dense.size() - 1;
+                if (position != last) {
+                    _dense[position] = _dense[last];
+                    _denseEntities[position] = _denseEntities[last];
+                    move(reinterpret_cast<Slot *>(_dense[position]), position);
+                }
+                _dense.pop_back();
+                _denseEntities.pop_back();
+            }
+
+            /*!
+             * @brief Update the position of a component moved in the dense arrays
+             * @param slot The slot of the component
+             * @param position The new position of the component
+             */
+            void move(Slot *slot, std::size_t position)
+            {
+                if (_sparse[slot->ownerID] == slot->position)
+                    _sparse[slot->ownerID] = position;
+                slot->position = position;
+            }
+
+            /*!
+             * @brief End an iteration and pack the dense arrays if it was the last one running on the sparse set
+             */
+            void endIteration()
+            {
+                if (--_iterating != 0 || _tombstones == 0)
+                    return;
+                std::size_t packed = 0;
+                for (std::size_t i = 0; i < _dense.size(); ++i) {
+                    if (_dense[i] == nullptr)
+                        continue;
+                    _dense[packed] = _dense[i];
+                    _denseEntities[packed] = _denseEntities[i];
+                    move(reinterpret_cast<Slot *>(_dense[packed]), packed);
+                    ++packed;
+                }
+                _dense.resize(packed);
+                _denseEntities.resize(packed);
+                _tombstones = 0;
+            }
+
+        private:
+            std::size_t _chunkSize; /*!< The number of slots of the next chunks */
+            std::vector<Chunk> _chunks; /*!< The chunks holding the components */
+            std::vector<std::unique_ptr<uint32_t[]>> _versions; /*!< The versions of the slots, never freed */
+            std::vector<std::pair<uint32_t *, std::size_t>> _freeVersions; /*!< Ranges of versions of freed chunks, used by the next chunks */
+            std::vector<Slot *> _freeSlots; /*!< The unused slots, the next one to use is at the back */
+            std::size_t _size; /*!< The number of living components */
+            std::vector<std::size_t> _sparse; /*!< For each entity id the position of its component in the dense arrays */
+            std::vector<C *> _dense; /*!< The components in the sparse set (nullptr if removed during an iteration) */
+            std::vector<entities::Entity *> _denseEntities; /*!< The entities of the components in _dense */
+            std::size_t _iterating; /*!< The number of iterations currently running on this storage */
+            std::size_t _tombstones; /*!< The number of components removed from the dense arrays while iterating */
+
+            static constexpr std::size_t npos = static_cast<std::size_t>(-1); /*!< An invalid position */
+        };
+    }
+}
+
+#else
+
+namespace jf {
+
+    namespace components {
+
+        class BaseComponentStorage;
+
+        template<typename C>
+        class ComponentStorage;
+    }
+}
+
+#endif //JFENTITYCOMPONENTSYSTEM_COMPONENTSTORAGE_HPP
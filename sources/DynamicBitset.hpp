@@ -0,0 +1,119 @@
+/*
+** EPITECH PROJECT, 2018
+** JFEntityComponentSystem
+** File description:
+** DynamicBitset.hpp
+*/
+
+/* Created the 17/10/2026 at 11:26 by jfrabel */
+
+#ifndef JFENTITYCOMPONENTSYSTEM_DYNAMICBITSET_HPP
+#define JFENTITYCOMPONENTSYSTEM_DYNAMICBITSET_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*!
+ * @namespace jf
+ * @brief The jfecs library namespace
+ */
+namespace jf {
+
+    /*!
+     * @namespace jf::internal
+     * @brief Do not use this namespace (used internally)
+     */
+    namespace internal {
+
+        /*!
+         * @class DynamicBitset
+         * @brief A set of bits indexed by entity id that grows when a bit past its end is set
+         *
+         * Bits are packed in 64 bits words so that a loop over the set bits skips 64 unset bits at once.
+         */
+        class DynamicBitset final {
+        public:
+            /*!
+             * @brief ctor, all bits are unset
+             */
+            DynamicBitset() = default;
+
+        public:
+            /*!
+             * @brief Set or unset a bit
+             * @param index The index of the bit
+             * @param value The new value of the bit
+             */
+            void set(std::size_t index, bool value)
+            {
+                std::size_t word = index / wordBits;
+                if (word >= _words.size()) {
+                    if (!value)
+                        return;
+                    _words.resize(word + 1, 0);
+                }
+                if (value)
+                    _words[word] |= uint64_t(1) << (index % wordBits);
+                else
+                    _words[word] &= ~(uint64_t(1) << (index % wordBits));
+            }
+
+            /*!
+             * @brief Get a bit
+             * @param index The index of the bit
+             * @return true if the bit is set false otherwise (bits past the end are unset)
+             */
+            bool test(std::size_t index) const
+            {
+                std::size_t word = index / wordBits;
+                return word < _words.size() && ((_words[word] >> (index % wordBits)) & 1) != 0;
+            }
+
+            /*!
+             * @brief Allocate ahead the memory of a number of bits
+             * @param count The number of bits
+             */
+            void reserve(std::size_t count)
+            {
+                _words.reserve((count + wordBits - 1) / wordBits);
+            }
+
+            /*!
+             * @brief Call a function with the index of each set bit, in increasing order
+             * @tparam Func The type of the callable (void(std::size_t))
+             * @param func The function to call
+             *
+             * func may change the bits, a word is read once before its bits are given to func.
+             */
+            template<typename Func>
+            void forEachSet(Func func) const
+            {
+                for (std::size_t word = 0; word < _words.size(); ++word) {
+                    uint64_t bits = _words[word];
+                    for (std::size_t bit = 0; bits != 0; ++bit, bits >>= 1) {
+                        if ((bits & 1) != 0)
+                            func(word * wordBits + bit);
+                    }
+                }
+            }
+
+        private:
+            static constexpr std::size_t wordBits = 64; /*!< The number of bits in a word */
+
+            std::vector<uint64_t> _words; /*!< The bits, bit i is the bit i % 64 of the word i / 64 */
+        };
+    }
+}
+
+#else
+
+namespace jf {
+
+    namespace internal {
+
+        class DynamicBitset;
+    }
+}
+
+#endif //JFENTITYCOMPONENTSYSTEM_DYNAMICBITSET_HPP
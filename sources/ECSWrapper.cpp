@@ -12,7 +12,8 @@
 ECSWrapper::ECSWrapper()
     : eventManager(jf::events::EventManager::getInstance()),
       entityManager(jf::entities::EntityManager::getInstance()),
-      systemManager(jf::systems::SystemManager::getInstance())
+      systemManager(jf::systems::SystemManager::getInstance()),
+      threadPool(jf::ThreadPool::getInstance())
 {
 
 }
@@ -13,6 +13,7 @@
 #include "EventManager.hpp"
 #include "EntityManager.hpp"
 #include "SystemManager.hpp"
+#include "ThreadPool.hpp"
 
 /*!
  * @struct ECSWrapper
@@ -26,6 +27,7 @@ struct ECSWrapper {
     jf::events::EventManager &eventManager; /*!< The EventManager singleton instance */
     jf::entities::EntityManager &entityManager; /*!< The EntityManager singleton instance */
     jf::systems::SystemManager &systemManager; /*!< The SystemManager singleton instance */
+    jf::ThreadPool &threadPool; /*!< The ThreadPool singleton instance */
 };
 
 #endif //JFENTITYCOMPONENTSYSTEM_ECSWRAPPER_HPP
@@ -0,0 +1,50 @@
+/*
+** EPITECH PROJECT, 2018
+** JFEntityComponentSystem
+** File description:
+** EntitiesCreatedEvent.hpp
+*/
+
+/* Created the 17/10/2026 at 09:14 by jfrabel */
+
+#ifndef JFENTITYCOMPONENTSYSTEM_ENTITIESCREATEDEVENT_HPP
+#define JFENTITYCOMPONENTSYSTEM_ENTITIESCREATEDEVENT_HPP
+
+#include <vector>
+#include "ID.hpp"
+
+/*!
+ * @namespace jf
+ * @brief The jfecs library namespace
+ */
+namespace jf {
+
+    /*!
+     * @namespace jf::events
+     * @brief A namespace handling event related stuff
+     */
+    namespace events {
+
+        /*!
+         * @struct EntitiesCreatedEvent
+         * @brief An event emitted once when several entities were created with EntityManager::createEntities
+         *
+         * Emitted after the components of the entities are assigned
+         */
+        struct EntitiesCreatedEvent {
+            std::vector<internal::ID> ids; /*!< The ids of the created entities */
+        };
+    }
+}
+
+#else
+
+namespace jf {
+
+    namespace events {
+
+        struct EntitiesCreatedEvent;
+    }
+}
+
+#endif //JFENTITYCOMPONENTSYSTEM_ENTITIESCREATEDEVENT_HPP
@@ -0,0 +1,50 @@
+/*
+** EPITECH PROJECT, 2018
+** JFEntityComponentSystem
+** File description:
+** EntitiesDestroyedEvent.hpp
+*/
+
+/* Created the 17/10/2026 at 09:14 by jfrabel */
+
+#ifndef JFENTITYCOMPONENTSYSTEM_ENTITIESDESTROYEDEVENT_HPP
+#define JFENTITYCOMPONENTSYSTEM_ENTITIESDESTROYEDEVENT_HPP
+
+#include <vector>
+#include "ID.hpp"
+
+/*!
+ * @namespace jf
+ * @brief The jfecs library namespace
+ */
+namespace jf {
+
+    /*!
+     * @namespace jf::events
+     * @brief A namespace handling event related stuff
+     */
+    namespace events {
+
+        /*!
+         * @struct EntitiesDestroyedEvent
+         * @brief An event emitted once when several entities are being destroyed with EntityManager::destroyEntities or EntityManager::deleteAllEntities
+         *
+         * Emitted before any of the entities is destroyed, they can still be retrieved with their ids
+         */
+        struct EntitiesDestroyedEvent {
+            std::vector<internal::ID> ids; /*!< The ids of the entities being destroyed */
+        };
+    }
+}
+
+#else
+
+namespace jf {
+
+    namespace events {
+
+        struct EntitiesDestroyedEvent;
+    }
+}
+
+#endif //JFENTITYCOMPONENTSYSTEM_ENTITIESDESTROYEDEVENT_HPP
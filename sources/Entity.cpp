@@ -9,22 +9,24 @@
 
 #include "Entity.hpp"
 #include "EntityManager.hpp"
-#include "Events.hpp"
-#include "EventManager.hpp"
 
 jf::entities::Entity::Entity(const internal::ID &id, const std::string &name)
-    : _id(id), _name(name), _components(), _enabled(true), _shouldBeKeeped(false)
+    : _id(id), _components(), _signature(), _nameID(internal::NameTable::getInstance().intern(name)), _shouldBeKeeped(false)
+{}
+
+jf::entities::Entity::Entity(const internal::ID &id, uint32_t nameID)
+    : _id(id), _components(), _signature(), _nameID(nameID), _shouldBeKeeped(false)
 {
-    events::EventManager::getInstance().emit<events::EntityCreatedEvent>({EntityHandler(this)});
+    internal::NameTable::getInstance().acquire(nameID);
 }
 
 jf::entities::Entity::~Entity()
 {
     for (auto &i : _components) {
-        delete i.second;
-        i.second = nullptr;
+        i.second.second->destroy(i.second.first);
+        i.second.first = nullptr;
     }
-    events::EventManager::getInstance().emit<events::EntityDestroyedEvent>({this});
+    internal::NameTable::getInstance().release(_nameID);
 }
 
 const jf::internal::ID &jf::entities::Entity::getID() const
@@ -34,17 +36,27 @@ const jf::internal::ID &jf::entities::Entity::getID() const
 
 const std::string &jf::entities::Entity::getName() const
 {
-    return _name;
+    return internal::NameTable::getInstance().getName(_nameID);
+}
+
+uint32_t jf::entities::Entity::getNameID() const
+{
+    return _nameID;
+}
+
+const jf::components::Signature &jf::entities::Entity::getSignature() const
+{
+    return _signature;
 }
 
 void jf::entities::Entity::setEnable(bool enabled)
 {
-    _enabled = enabled;
+    EntityManager::getInstance().setEnable(_id, enabled);
 }
 
 bool jf::entities::Entity::isEnabled() const
 {
-    return _enabled;
+    return EntityManager::getInstance().isEnabled(_id);
 }
 
 void jf::entities::Entity::setShouldBeKeeped(bool keep)
@@ -55,4 +67,45 @@ void jf::entities::Entity::setShouldBeKeeped(bool keep)
 bool jf::entities::Entity::shouldBeKeeped() const
 {
     return _shouldBeKeeped;
-}
\ No newline at end of file
+}
+
+void jf::entities::Entity::notifyComponentChanged(const std::type_index &type)
+{
+    EntityManager::getInstance().onComponentChanged(*this, type);
+}
+
+jf::components::Component *jf::entities::Entity::getComponentByType(const std::type_index &type) const
+{
+    auto component = _components.find(type);
+    if (component == _components.end())
+        return nullptr;
+    return component->second.first;
+}
+
+std::vector<std::pair<std::type_index, jf::components::BaseComponentStorage *>> jf::entities::Entity::getComponentTypes() const
+{
+    std::vector<std::pair<std::type_index, components::BaseComponentStorage *>> types;
+    types.reserve(_components.size());
+    for (auto &component : _components)
+        types.emplace_back(component.first, component.second.second);
+    return types;
+}
+
+void jf::entities::Entity::attachComponent(const std::type_index &type, components::Component *component,
+    components::BaseComponentStorage *storage)
+{
+    _components.insert(std::make_pair(type, std::make_pair(component, storage)));
+    _signature.set(storage->getTypeID());
+    notifyComponentChanged(type);
+}
+
+void jf::entities::Entity::reserveComponents(std::size_t count)
+{
+    _components.reserve(count);
+}
+
+void jf::entities::Entity::forgetComponents()
+{
+    _components.clear();
+    _signature.reset();
+}
@@ -11,11 +11,15 @@
 #define PROJECT_ENTITY_HPP
 
 #include <unordered_map>
+#include <vector>
 #include "Exceptions.hpp"
 #include "Internal.hpp"
 #include "ID.hpp"
+#include "NameTable.hpp"
+#include "Signature.hpp"
 #include "Component.hpp"
 #include "ComponentHandler.hpp"
+#include "ComponentStorage.hpp"
 
 /*!
  * @namespace jf
@@ -44,6 +48,11 @@ namespace jf {
              * DO NOT create entity manually use the EntityManager or the helper function createEntity()
              */
             Entity(const internal::ID &id, const std::string &name);
+            /*!
+             * @brief Create an Entity with an already interned name, the entity takes its own reference on the name.
+             * DO NOT create entity manually use the EntityManager or the helper function createEntity()
+             */
+            Entity(const internal::ID &id, uint32_t nameID);
 
             /*!
              * @brief dtor
@@ -106,6 +115,8 @@ namespace jf {
              * @tparam CB The second type of required component
              * @tparam Others The other types of required components (can be empty)
              * @return true if the entity possess all the required components false otherwise
+             *
+             * The required components are checked at once against the signature of the entity.
              */
             template<typename CA, typename CB, typename... Others>
             bool hasComponents();
@@ -138,10 +149,24 @@ namespace jf {
              * @return The name of this entity
              */
             const std::string &getName() const;
+            /*!
+             * @brief Get the id of the name of this entity in the NameTable
+             * @return The id of the name of this entity, entities with the same name have the same id
+             */
+            uint32_t getNameID() const;
+
+            /*!
+             * @brief Get the set of the component types of this entity
+             * @return The signature of this entity, the bit of each component type it has is set
+             */
+            const components::Signature &getSignature() const;
 
             /*!
              * @brief Enable/dissable an entity
              * @param enabled The value to set
+             *
+             * The state is stored by the EntityManager in a bitset indexed by entity id
+             * so that queries skip disabled entities without reading them.
              */
             void setEnable(bool enabled);
 
@@ -163,22 +188,63 @@ namespace jf {
              */
             bool shouldBeKeeped() const;
 
+            /*!
+             * @brief Method used internally by prefabs to get a component without knowing its type
+             * @param type The type of the component
+             * @return The component or nullptr if the entity has no component of this type
+             */
+            components::Component *getComponentByType(const std::type_index &type) const;
+
+            /*!
+             * @brief Method used internally by prefabs to list the components of this entity
+             * @return The type and the storage of each component of this entity
+             */
+            std::vector<std::pair<std::type_index, components::BaseComponentStorage *>> getComponentTypes() const;
+
+            /*!
+             * @brief Method used internally by prefabs to add a component created by a storage
+             * @param type The type of the component, the entity must not already have a component of this type
+             * @param component The component
+             * @param storage The storage that created the component
+             */
+            void attachComponent(const std::type_index &type, components::Component *component, components::BaseComponentStorage *storage);
+
+            /*!
+             * @brief Method used internally by prefabs to allocate ahead the room for a number of components
+             * @param count The number of components
+             */
+            void reserveComponents(std::size_t count);
+
+            /*!
+             * @brief Method used internally by the EntityManager to drop the components its storages are about to destroy
+             */
+            void forgetComponents();
+
+        private:
+            /*!
+             * @brief Tell the EntityManager that a component was assigned or removed so that views are updated
+             * @param type The type of the component
+             */
+            void notifyComponentChanged(const std::type_index &type);
+
         private:
             const internal::ID _id; /*!< An id identifing this object (will be unique) */
-            const std::string _name; /*!< A name identifing this object (does not need to be unique) */
-            std::unordered_map<std::type_index, components::Component *> _components; /*!< The components of this obj */
-            bool _enabled; /*!< A boolean used to know if an entity is enabled or not */
+            std::unordered_map<std::type_index, std::pair<components::Component *, components::BaseComponentStorage *>> _components; /*!< The components of this obj and their storages */
+            components::Signature _signature; /*!< The component types of this obj */
+            const uint32_t _nameID; /*!< The interned name identifing this object (does not need to be unique) */
             bool _shouldBeKeeped; /*!< A boolean used to know if an entity should be kept when destroyAll is called */
         };
 
         template<typename C>
         components::ComponentHandler<C> Entity::getComponent()
         {
+            if (components::UseSparseSet<C>::value)
+                return components::ComponentHandler<C>(components::ComponentStorage<C>::getInstance().get(_id));
             auto elem = _components.find(internal::getTypeIndex<C>());
             if (elem == _components.end())
                 return components::ComponentHandler<C>();
             else
-                return components::ComponentHandler<C>(reinterpret_cast<C *>(elem->second));
+                return components::ComponentHandler<C>(static_cast<C *>(elem->second.first));
         }
 
         template<typename C>
@@ -198,7 +264,7 @@ namespace jf {
         template<typename C>
         bool Entity::hasComponent()
         {
-            return (_components.count(internal::getTypeIndex<C>()) != 0);
+            return _signature.test(components::getComponentTypeID<C>());
         }
 
         template<typename C>
@@ -210,31 +276,50 @@ namespace jf {
         template<typename CA, typename CB, typename... Others>
         bool Entity::hasComponents()
         {
-            return (hasComponent<CA>() && hasComponents<CB, Others...>());
+            const components::Signature &required = components::getSignature<CA, CB, Others...>();
+            return (_signature & required) == required;
         }
 
         template<typename C, typename... Params>
         components::ComponentHandler<C> Entity::assignComponent(Params... params)
         {
-            C *newComp = new C(*this, params...);
+            std::size_t typeID = components::getComponentTypeID<C>();
+            auto &storage = components::ComponentStorage<C>::getInstance();
+            C *newComp = storage.create(*this, _id, params...);
             auto oldComp = _components.find(internal::getTypeIndex<C>());
             if (oldComp != _components.end()) {
-                delete oldComp->second;
-                oldComp->second = newComp;
+                auto replaced = oldComp->second;
+                oldComp->second = std::make_pair(newComp, &storage);
+                notifyComponentChanged(internal::getTypeIndex<C>());
+                replaced.second->destroy(replaced.first);
             } else {
-                _components.insert(std::make_pair(internal::getTypeIndex<C>(), newComp));
+                _components.insert(std::make_pair(internal::getTypeIndex<C>(), std::make_pair(newComp, &storage)));
+                _signature.set(typeID);
+                notifyComponentChanged(internal::getTypeIndex<C>());
             }
-            return components::ComponentHandler<C>(
-                reinterpret_cast<C *>(_components.find(internal::getTypeIndex<C>())->second));
+            return components::ComponentHandler<C>(newComp);
         }
 
         template<typename C>
         bool Entity::removeComponent()
         {
+            if (components::UseSparseSet<C>::value) {
+                C *component = components::ComponentStorage<C>::getInstance().get(_id);
+                if (component == nullptr)
+                    return false;
+                _components.erase(internal::getTypeIndex<C>());
+                _signature.reset(components::getComponentTypeID<C>());
+                components::ComponentStorage<C>::getInstance().destroy(component);
+                notifyComponentChanged(internal::getTypeIndex<C>());
+                return true;
+            }
             auto comp = _components.find(internal::getTypeIndex<C>());
             if (comp != _components.end()) {
-                delete comp->second;
+                auto removed = comp->second;
                 _components.erase(comp);
+                _signature.reset(components::getComponentTypeID<C>());
+                removed.second->destroy(removed.first);
+                notifyComponentChanged(internal::getTypeIndex<C>());
                 return true;
             }
             return false;
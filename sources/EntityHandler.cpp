@@ -0,0 +1,102 @@
+/*
+** EPITECH PROJECT, 2018
+** JFEntityComponentSystem
+** File description:
+** EntityHandler.cpp
+*/
+
+/* Created the 16/10/2026 at 16:21 by jfrabel */
+
+#include <type_traits>
+#include "EntityHandler.hpp"
+#include "EntityManager.hpp"
+
+static_assert(std::is_trivially_copyable<jf::entities::EntityHandler>::value, "EntityHandler should be trivially copyable");
+
+jf::entities::EntityHandler::EntityHandler()
+    : _id(), _generation(0)
+{}
+
+jf::entities::EntityHandler::EntityHandler(jf::entities::Entity *entity)
+    : _id(), _generation(0)
+{
+    set(entity);
+}
+
+jf::entities::EntityHandler::EntityHandler(const jf::internal::ID &entityID, uint32_t generation)
+    : _id(entityID), _generation(generation)
+{}
+
+jf::entities::Entity &jf::entities::EntityHandler::operator*()
+{
+    Entity *entity = get();
+    if (entity == nullptr)
+        throw jf::BadHandlerException("Invalid EntityHandler", "EntityHandler");
+    return *entity;
+}
+
+const jf::entities::Entity &jf::entities::EntityHandler::operator*() const
+{
+    Entity *entity = get();
+    if (entity == nullptr)
+        throw jf::BadHandlerException("Invalid EntityHandler", "EntityHandler");
+    return *entity;
+}
+
+jf::entities::Entity *jf::entities::EntityHandler::operator->()
+{
+    Entity *entity = get();
+    if (entity == nullptr)
+        throw jf::BadHandlerException("Invalid EntityHandler", "EntityHandler");
+    return entity;
+}
+
+const jf::entities::Entity *jf::entities::EntityHandler::operator->() const
+{
+    Entity *entity = get();
+    if (entity == nullptr)
+        throw jf::BadHandlerException("Invalid EntityHandler", "EntityHandler");
+    return entity;
+}
+
+bool jf::entities::EntityHandler::operator==(const jf::entities::EntityHandler &rhs) const
+{
+    if (!isValid() && !rhs.isValid())
+        return true;
+    if (!isValid() || !rhs.isValid())
+        return false;
+    return _id == rhs._id && _generation == rhs._generation;
+}
+
+bool jf::entities::EntityHandler::isValid() const
+{
+    return get() != nullptr;
+}
+
+jf::entities::Entity *jf::entities::EntityHandler::get() const
+{
+    if (!_id.isValid())
+        return nullptr;
+    return EntityManager::getInstance().getEntityPointer(_id, _generation);
+}
+
+void jf::entities::EntityHandler::set(jf::entities::Entity *entity)
+{
+    if (entity == nullptr) {
+        _id = internal::ID();
+        _generation = 0;
+        return;
+    }
+    _id = entity->getID();
+    _generation = EntityManager::getInstance().getGeneration(_id);
+}
+
+const jf::internal::ID &jf::entities::EntityHandler::getID() const
+{
+    return _id;
+}
+
+uint32_t jf::entities::EntityHandler::getGeneration() const
+{
+    return _generation;
+}
@@ -10,10 +10,9 @@
 #ifndef JFENTITYCOMPONENTSYSTEM_ENTITYHANDLER_HPP
 #define JFENTITYCOMPONENTSYSTEM_ENTITYHANDLER_HPP
 
+#include <cstdint>
 #include "ID.hpp"
 #include "Entity.hpp"
-#include "EntityDestroyedEvent.hpp"
-#include "EventManager.hpp"
 
 /*!
  * @namespace jf
@@ -33,6 +32,11 @@ namespace jf {
          *
          * A handler can be valid or invalid.
          * An invalid handler is a handler that manages no entity or a destroyed one.
+         *
+         * A handler is an entity id and the generation of this id when the handler was created.
+         * Each time an entity is destroyed the generation of its id is incremented in the EntityManager
+         * so a handler on a destroyed entity is invalid even if the id has been reused.
+         * Handlers are trivially copyable and do not register anything so they can be created and copied freely.
          */
         class EntityHandler {
         public:
@@ -40,51 +44,20 @@ namespace jf {
             /*!
              * @brief default ctor, this will create an invalid EntityHandler
              */
-            EntityHandler(): _ptr(nullptr), _eventListenerID()
-            {
-                _eventListenerID = events::EventManager::getInstance().addListener<EntityHandler, events::EntityDestroyedEvent>(
-                    this,
-                    [](EntityHandler *data, events::EntityDestroyedEvent event) {
-                        if (event.entity == data->get())
-                            data->set(nullptr);
-                    });
-            }
+            EntityHandler();
 
             /*!
              * @brief ctor
              * @param entity The entity to handle
              */
-            explicit EntityHandler(Entity *entity): _ptr(entity), _eventListenerID()
-            {
-                _eventListenerID = events::EventManager::getInstance().addListener<EntityHandler, events::EntityDestroyedEvent>(
-                    this,
-                    [](EntityHandler *data, events::EntityDestroyedEvent event) {
-                        if (event.entity == data->get())
-                            data->set(nullptr);
-                    });
-            }
-
-            /*!
-             * @brief cpy ctor
-             * @param other The handler to copy
-             */
-            EntityHandler(const EntityHandler &other): _ptr(other._ptr), _eventListenerID()
-            {
-                _eventListenerID = events::EventManager::getInstance().addListener<EntityHandler, events::EntityDestroyedEvent>(
-                    this,
-                    [](EntityHandler *data, events::EntityDestroyedEvent event) {
-                        if (event.entity == data->get())
-                            data->set(nullptr);
-                    });
-            }
+            explicit EntityHandler(Entity *entity);
 
             /*!
-             * @brief dtor
+             * @brief ctor
+             * @param entityID The id of the entity to handle
+             * @param generation The generation of the id of the entity to handle
              */
-            virtual ~EntityHandler()
-            {
-                events::EventManager::getInstance().removeListener(_eventListenerID);
-            }
+            EntityHandler(const internal::ID &entityID, uint32_t generation);
 
         public:
             /*!
@@ -92,103 +65,71 @@ namespace jf {
              * @return A reference on the managed entity
              * @throw jf::BadHandlerException if this handler is invalid (destroyed entity, uninitialized handler)
              */
-            virtual Entity &operator*()
-            {
-                if (!isValid())
-                    throw jf::BadHandlerException("Invalid EntityHandler", "EntityHandler");
-                return *_ptr;
-            }
+            Entity &operator*();
 
             /*!
              * @brief operator* const
              * @return A const reference on the managed entity
              * @throw jf::BadHandlerException if this handler is invalid (destroyed entity, uninitialized handler)
              */
-            virtual const Entity &operator*() const
-            {
-                if (!isValid())
-                    throw jf::BadHandlerException("Invalid EntityHandler", "EntityHandler");
-                return *_ptr;
-            }
+            const Entity &operator*() const;
 
             /*!
              * @brief operator ->
              * @return A pointer to the managed entity
              * @throw jf::BadHandlerException if this handler is invalid (destroyed entity, uninitialized handler)
              */
-            virtual Entity *operator->()
-            {
-                if (!isValid())
-                    throw jf::BadHandlerException("Invalid EntityHandler", "EntityHandler");
-                return _ptr;
-            }
+            Entity *operator->();
 
             /*!
              * @brief operator -> const
              * @return A pointer to the const managed entity
              * @throw jf::BadHandlerException if this handler is invalid (destroyed entity, uninitialized handler)
              */
-            virtual const Entity *operator->() const
-            {
-                if (!isValid())
-                    throw jf::BadHandlerException("Invalid EntityHandler", "EntityHandler");
-                return _ptr;
-            }
+            const Entity *operator->() const;
 
             /*!
              * @brief equality operator
              * @param rhs The EntityHandler to compare to
              * @return true if the two handler manage the same entity false otherwise (return true if both invalid)
              */
-            virtual bool operator==(const EntityHandler &rhs) const
-            {
-                if (!isValid() && !rhs.isValid())
-                    return true;
-                if (!isValid() || !rhs.isValid())
-                    return false;
-                return _ptr == rhs._ptr;
-            }
-
-            EntityHandler &operator=(const EntityHandler &other)
-            {
-                if (&other == this)
-                    return *this;
-                _ptr = other._ptr;
-                return *this;
-            }
+            bool operator==(const EntityHandler &rhs) const;
 
         public:
             /*!
              * @brief check if this handler is valid
              * @return true if the handler is valid false otherwise
              */
-            virtual bool isValid() const
-            {
-                return _ptr != nullptr;
-            }
+            bool isValid() const;
 
             /*!
              * @brief An other way to get the managed entity without a throw
-             * @return The managed pointer
+             * @return The managed pointer, nullptr if the handler is invalid
              * DO NOT store an Entity directly always use an EntityHandler
              */
-            virtual Entity *get()
-            {
-                return _ptr;
-            }
+            Entity *get() const;
 
             /*!
              * @brief Set the managed Entity
              * @param entity the entity to manage
              */
-            virtual void set(Entity *entity)
-            {
-                _ptr = entity;
-            }
+            void set(Entity *entity);
+
+            /*!
+             * @brief Get the id of the managed entity
+             * @return The id of the managed entity (the entity may have been destroyed)
+             */
+            const internal::ID &getID() const;
+
+            /*!
+             * @brief Get the generation of the id of the managed entity
+             * @return The generation given by the EntityManager when the handler was set
+             */
+            uint32_t getGeneration() const;
 
         private:
-            Entity *_ptr; /*!< The managed entity, will be nullptr if invalid */
-            internal::ID _eventListenerID; /*!< The id of the event invalidating this handler on component destruction*/
+            internal::ID _id; /*!< The id of the managed entity, invalid if the handler manages nothing */
+            uint32_t _generation; /*!< The generation of the id of the managed entity */
         };
     }
 }
@@ -8,7 +8,10 @@
 /* Created the 12/04/2019 at 11:12 by jfrabel */
 
 #include <algorithm>
+#include <new>
 #include "EntityManager.hpp"
+#include "Events.hpp"
+#include "EventManager.hpp"
 
 jf::entities::EntityManager &jf::entities::EntityManager::getInstance()
 {
@@ -17,53 +20,203 @@ jf::entities::EntityManager &jf::entities::EntityManager::getInstance()
 }
 
 jf::entities::EntityManager::EntityManager()
-    : _maxId(0), _entities(), _freeIDs(), _toDestroyIDs()
+    : _maxId(0), _chunks(), _slots(), _freeIDs(), _entitiesByName(), _namePositions(), _enabled(), _toDestroyIDs(), _toDestroyMutex(), _views(), _viewsMutex(), _viewsByComponent()
 {
-
+    /* Make sure the EventManager and the NameTable are created first so that they are destroyed after this manager */
+    events::EventManager::getInstance();
+    internal::NameTable::getInstance();
 }
 
 void jf::entities::EntityManager::registerNewEntity(jf::entities::Entity *entity)
 {
-    auto existing = _entities.find(entity->getID());
-    if (existing != _entities.end()) {
+    uint64_t index = entity->getID().getID();
+    if (index < _slots.size() && _slots[index].second != nullptr) {
         throw EntityAlreadyRegisteredException("Entity ID already existing", "registerNewEntity");
     }
-    _entities.insert(std::make_pair(entity->getID(), entity));
+    if (index >= _slots.size())
+        _slots.resize(index + 1, std::make_pair(0, nullptr));
+    _slots[index].second = entity;
+    _enabled.set(index, true);
+    indexName(entity);
+}
+
+void jf::entities::EntityManager::indexName(jf::entities::Entity *entity)
+{
+    uint64_t index = entity->getID().getID();
+    if (index >= _namePositions.size())
+        _namePositions.resize(_slots.size(), 0);
+    if (entity->getNameID() >= _entitiesByName.size())
+        _entitiesByName.resize(entity->getNameID() + 1);
+    auto &entities = _entitiesByName[entity->getNameID()];
+    _namePositions[index] = entities.size();
+    entities.push_back(index);
+}
+
+void jf::entities::EntityManager::unindexName(jf::entities::Entity *entity)
+{
+    auto &entities = _entitiesByName[entity->getNameID()];
+    std::size_t position = _namePositions[entity->getID().getID()];
+    uint64_t last = entities.back();
+    entities[position] = last;
+    _namePositions[last] = position;
+    entities.pop_back();
+}
+
+void *jf::entities::EntityManager::getEntityMemory(const jf::internal::ID &entityID)
+{
+    std::size_t chunk = entityID.getID() / entityChunkSize;
+    if (chunk >= _chunks.size())
+        _chunks.resize(chunk + 1);
+    if (_chunks[chunk] == nullptr)
+        _chunks[chunk].reset(new EntityMemory[entityChunkSize]);
+    return &_chunks[chunk][entityID.getID() % entityChunkSize];
 }
 
 bool jf::entities::EntityManager::unregisterEntity(const jf::internal::ID &entityID)
 {
-    auto existing = _entities.find(entityID);
-    if (existing != _entities.end()) {
-        _freeIDs.emplace(entityID);
-        delete existing->second;
-        _entities.erase(existing);
-        return true;
+    uint64_t index = entityID.getID();
+    if (index >= _slots.size() || _slots[index].second == nullptr)
+        return false;
+    Entity *entity = _slots[index].second;
+    events::EventManager::getInstance().emit<events::EntityDestroyedEvent>({entity});
+    for (auto &view : _views)
+        view.second->remove(*entity);
+    releaseEntity(entity);
+    return true;
+}
+
+void jf::entities::EntityManager::releaseEntity(jf::entities::Entity *entity)
+{
+    uint64_t index = entity->getID().getID();
+    detachEntity(entity);
+    entity->~Entity();
+    _freeIDs.emplace(index);
+}
+
+void jf::entities::EntityManager::detachEntity(jf::entities::Entity *entity)
+{
+    uint64_t index = entity->getID().getID();
+    unindexName(entity);
+    _enabled.set(index, false);
+    auto &slot = _slots[index];
+    slot.second = nullptr;
+    ++slot.first;
+}
+
+void jf::entities::EntityManager::releaseEntityMemory()
+{
+    for (std::size_t chunk = 0; chunk < _chunks.size(); ++chunk) {
+        std::size_t end = std::min((chunk + 1) * entityChunkSize, _slots.size());
+        bool used = false;
+        for (std::size_t i = chunk * entityChunkSize; i < end && !used; ++i)
+            used = _slots[i].second != nullptr;
+        if (!used)
+            _chunks[chunk].reset();
     }
-    return false;
+    for (auto &entities : _entitiesByName)
+        entities.shrink_to_fit();
 }
 
-jf::entities::EntityHandler jf::entities::EntityManager::createEntity(const std::string &name)
+jf::entities::Entity *jf::entities::EntityManager::constructEntity(uint32_t nameID)
 {
-    Entity *entity;
-    if (_freeIDs.empty()) {
+    internal::ID id(_freeIDs.empty() ? _maxId + 1 : _freeIDs.front().getID());
+    auto *entity = new (getEntityMemory(id)) Entity(id, nameID);
+    if (_freeIDs.empty())
         ++_maxId;
-        entity = new Entity(internal::ID(_maxId), name);
-    } else {
-        internal::ID id = _freeIDs.front();
+    else
         _freeIDs.pop();
-        entity = new Entity(internal::ID(id.getID()), name);
-    }
     registerNewEntity(entity);
-    return getEntityByID(entity->getID());
+    return entity;
+}
+
+void jf::entities::EntityManager::notifyEntitiesCreated(const std::vector<jf::internal::ID> &entityIDs)
+{
+    auto &eventManager = events::EventManager::getInstance();
+    if (eventManager.hasListeners<events::EntityCreatedEvent>()) {
+        for (auto &id : entityIDs) {
+            if (getEntityPointer(id, getGeneration(id)) != nullptr)
+                eventManager.emit<events::EntityCreatedEvent>({EntityHandler(id, getGeneration(id))});
+        }
+    }
+    if (eventManager.hasListeners<events::EntitiesCreatedEvent>())
+        eventManager.emit<events::EntitiesCreatedEvent>({entityIDs});
+}
+
+std::vector<jf::internal::ID> jf::entities::EntityManager::instantiate(const jf::entities::Prefab &prefab, std::size_t count)
+{
+    const Entity &source = *prefab.getTemplate();
+    std::vector<std::pair<const std::pair<std::type_index, components::BaseComponentStorage *> *, components::Component *>> components;
+    components.reserve(prefab.getComponentTypes().size());
+    for (auto &type : prefab.getComponentTypes()) {
+        components::Component *component = source.getComponentByType(type.first);
+        if (component == nullptr)
+            continue;
+        if (!type.second->isCopyable())
+            throw ComponentNotCopyableException("A component of the template has no copy constructor", "instantiate");
+        components.emplace_back(&type, component);
+    }
+    reserve(_maxId - _freeIDs.size() + count);
+    std::vector<internal::ID> entityIDs;
+    std::vector<Entity *> entities;
+    entityIDs.reserve(count);
+    entities.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        Entity *entity = constructEntity(source.getNameID());
+        entity->reserveComponents(components.size());
+        entityIDs.push_back(entity->getID());
+        entities.push_back(entity);
+    }
+    for (auto &component : components)
+        component.first->second->cloneN(*component.second, entities, component.first->first);
+    notifyEntitiesCreated(entityIDs);
+    return entityIDs;
+}
+
+std::size_t jf::entities::EntityManager::destroyEntities(const std::vector<jf::internal::ID> &entityIDs)
+{
+    auto &eventManager = events::EventManager::getInstance();
+    if (eventManager.hasListeners<events::EntitiesDestroyedEvent>()) {
+        events::EntitiesDestroyedEvent event;
+        event.ids.reserve(entityIDs.size());
+        for (auto &id : entityIDs) {
+            if (id.getID() < _slots.size() && _slots[id.getID()].second != nullptr)
+                event.ids.push_back(id);
+        }
+        eventManager.emit<events::EntitiesDestroyedEvent>(event);
+    }
+    std::size_t destroyed = 0;
+    for (auto &id : entityIDs) {
+        if (unregisterEntity(id))
+            ++destroyed;
+    }
+    return destroyed;
+}
+
+jf::entities::EntityHandler jf::entities::EntityManager::createEntity(const std::string &name)
+{
+    auto &names = internal::NameTable::getInstance();
+    uint32_t nameID = names.intern(name);
+    Entity *entity = constructEntity(nameID);
+    names.release(nameID);
+    EntityHandler handler(entity->getID(), getGeneration(entity->getID()));
+    events::EventManager::getInstance().emit<events::EntityCreatedEvent>({handler});
+    return handler;
 }
 
 jf::entities::EntityHandler jf::entities::EntityManager::getEntityByID(const jf::internal::ID &entityID)
 {
-    auto entity = _entities.find(entityID);
-    if (entity == _entities.end())
+    uint64_t index = entityID.getID();
+    if (index >= _slots.size() || _slots[index].second == nullptr)
         return jf::entities::EntityHandler();
-    return jf::entities::EntityHandler(entity->second);
+    return jf::entities::EntityHandler(entityID, _slots[index].first);
+}
+
+uint32_t jf::entities::EntityManager::getGeneration(const jf::internal::ID &entityID) const
+{
+    uint64_t index = entityID.getID();
+    if (index >= _slots.size())
+        return 0;
+    return _slots[index].first;
 }
 
 bool jf::entities::EntityManager::deleteEntity(const jf::internal::ID &entityID)
@@ -73,26 +226,69 @@ bool jf::entities::EntityManager::deleteEntity(const jf::internal::ID &entityID)
 
 void jf::entities::EntityManager::applyToEach(std::function<void(EntityHandler)> func, bool onlyEnabled)
 {
-    for (auto &entity : _entities) {
-        if (entity.second->isEnabled() || !onlyEnabled)
-            func(EntityHandler(entity.second));
+    if (onlyEnabled) {
+        _enabled.forEachSet([this, &func](std::size_t index) {
+            if (_enabled.test(index))
+                func(EntityHandler(_slots[index].second));
+        });
+        return;
     }
+    for (std::size_t i = 0; i < _slots.size(); ++i) {
+        Entity *entity = _slots[i].second;
+        if (entity != nullptr)
+            func(EntityHandler(entity));
+    }
+}
+
+void jf::entities::EntityManager::setEnable(const jf::internal::ID &entityID, bool enabled)
+{
+    uint64_t index = entityID.getID();
+    if (index < _slots.size() && _slots[index].second != nullptr)
+        _enabled.set(index, enabled);
+}
+
+void jf::entities::EntityManager::setEnable(const std::vector<jf::internal::ID> &entityIDs, bool enabled)
+{
+    for (auto &id : entityIDs)
+        setEnable(id, enabled);
+}
+
+void jf::entities::EntityManager::reserve(std::size_t count)
+{
+    if (count == 0)
+        return;
+    _slots.reserve(count + 1);
+    _namePositions.reserve(count + 1);
+    _enabled.reserve(count + 1);
+    for (std::size_t id = 0; id <= count; id += entityChunkSize)
+        getEntityMemory(internal::ID(id));
+    getEntityMemory(internal::ID(count));
 }
 
 jf::entities::EntityManager::~EntityManager()
 {
-    for (auto &entity : _entities) {
-        delete entity.second;
+    for (std::size_t i = 0; i < _slots.size(); ++i) {
+        Entity *entity = _slots[i].second;
+        if (entity == nullptr)
+            continue;
+        events::EventManager::getInstance().emit<events::EntityDestroyedEvent>({entity});
+        _slots[i].second = nullptr;
+        entity->~Entity();
+    }
+    for (auto &view : _views) {
+        delete view.second;
     }
 }
 
 jf::entities::EntityHandler jf::entities::EntityManager::getEntityByName(
     const std::string &entityName, bool onlyEnabled)
 {
-    for (auto &entity : _entities) {
-        if (entity.second != nullptr && entity.second->getName() == entityName
-        && (entity.second->isEnabled() || !onlyEnabled))
-            return jf::entities::EntityHandler(entity.second);
+    uint32_t nameID;
+    if (!internal::NameTable::getInstance().find(entityName, nameID) || nameID >= _entitiesByName.size())
+        return jf::entities::EntityHandler();
+    for (auto &index : _entitiesByName[nameID]) {
+        if (!onlyEnabled || _enabled.test(index))
+            return jf::entities::EntityHandler(_slots[index].second);
     }
     return jf::entities::EntityHandler();
 }
@@ -101,36 +297,96 @@ std::vector<jf::entities::EntityHandler> jf::entities::EntityManager::getEntitie
     const std::string &entityName, bool onlyEnabled)
 {
     std::vector<jf::entities::EntityHandler> matching;
-    for (auto &entity : _entities) {
-        if (entity.second != nullptr && entity.second->getName() == entityName
-        && (entity.second->isEnabled() || !onlyEnabled))
-            matching.emplace_back(entity.second);
+    uint32_t nameID;
+    if (!internal::NameTable::getInstance().find(entityName, nameID) || nameID >= _entitiesByName.size())
+        return matching;
+    matching.reserve(_entitiesByName[nameID].size());
+    for (auto &index : _entitiesByName[nameID]) {
+        if (!onlyEnabled || _enabled.test(index))
+            matching.emplace_back(_slots[index].second);
     }
     return matching;
 }
 
-void jf::entities::EntityManager::deleteAllEntities()
+void jf::entities::EntityManager::deleteAllEntities(bool releaseMemory)
 {
-    auto entity = std::find_if(_entities.begin(), _entities.end(), [](const std::pair<internal::ID, Entity *> &pair) {
-        return !pair.second->shouldBeKeeped();
-    });
-    while (entity != _entities.end()) {
-        deleteEntity(entity->first);
-        entity = std::find_if(_entities.begin(), _entities.end(), [](const std::pair<internal::ID, Entity *> &pair) {
-            return !pair.second->shouldBeKeeped();
-        });
+    std::vector<internal::ID> entityIDs;
+    std::vector<uint32_t> generations;
+    for (std::size_t i = 0; i < _slots.size(); ++i) {
+        if (_slots[i].second != nullptr && !_slots[i].second->shouldBeKeeped()) {
+            entityIDs.emplace_back(i);
+            generations.push_back(_slots[i].first);
+        }
+    }
+    auto &eventManager = events::EventManager::getInstance();
+    if (eventManager.hasListeners<events::EntitiesDestroyedEvent>())
+        eventManager.emit<events::EntitiesDestroyedEvent>({entityIDs});
+    if (eventManager.hasListeners<events::EntityDestroyedEvent>()) {
+        for (std::size_t i = 0; i < entityIDs.size(); ++i) {
+            Entity *entity = getEntityPointer(entityIDs[i], generations[i]);
+            if (entity != nullptr)
+                eventManager.emit<events::EntityDestroyedEvent>({entity});
+        }
     }
+    /* Listeners may have destroyed some of the entities */
+    internal::DynamicBitset owners;
+    owners.reserve(_slots.size());
+    std::vector<Entity *> dying;
+    dying.reserve(entityIDs.size());
+    for (std::size_t i = 0; i < entityIDs.size(); ++i) {
+        Entity *entity = getEntityPointer(entityIDs[i], generations[i]);
+        if (entity == nullptr)
+            continue;
+        owners.set(entityIDs[i].getID(), true);
+        dying.push_back(entity);
+    }
+    /* Like in releaseEntity the entities are unregistered before their components are destroyed,
+     * so the destructors and listeners of the components only see invalid handlers and entities without components */
+    for (auto *entity : dying) {
+        for (auto &view : _views)
+            view.second->remove(*entity);
+        entity->forgetComponents();
+        detachEntity(entity);
+    }
+    for (auto &storage : components::BaseComponentStorage::getStorages()) {
+        if (storage->size() != 0)
+            storage->destroyOwnedBy(owners);
+    }
+    for (auto *entity : dying) {
+        uint64_t index = entity->getID().getID();
+        entity->~Entity();
+        _freeIDs.emplace(index);
+    }
+    if (!releaseMemory)
+        return;
+    for (auto &storage : components::BaseComponentStorage::getStorages())
+        storage->shrink();
+    releaseEntityMemory();
+}
+
+void jf::entities::EntityManager::onComponentChanged(jf::entities::Entity &entity, const std::type_index &type)
+{
+    auto views = _viewsByComponent.find(type);
+    if (views == _viewsByComponent.end())
+        return;
+    for (auto &view : views->second)
+        view->update(entity);
 }
 
 void jf::entities::EntityManager::safeDeleteEntity(const jf::internal::ID &entityID)
 {
+    std::lock_guard<std::mutex> lock(_toDestroyMutex);
     _toDestroyIDs.push_back(entityID);
 }
 
 void jf::entities::EntityManager::applySafeDelete()
 {
-    for (auto &id : _toDestroyIDs) {
+    std::vector<internal::ID> toDestroyIDs;
+    {
+        std::lock_guard<std::mutex> lock(_toDestroyMutex);
+        toDestroyIDs.swap(_toDestroyIDs);
+    }
+    for (auto &id : toDestroyIDs) {
         unregisterEntity(id);
     }
-    _toDestroyIDs.clear();
 }
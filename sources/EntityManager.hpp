@@ -10,11 +10,22 @@
 #ifndef JFENTITYCOMPONENTSYSTEM_ENTITYMANAGER_HPP
 #define JFENTITYCOMPONENTSYSTEM_ENTITYMANAGER_HPP
 
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <type_traits>
 #include <vector>
 #include <unordered_map>
 #include "ID.hpp"
+#include "NameTable.hpp"
+#include "DynamicBitset.hpp"
 #include "Entity.hpp"
 #include "EntityHandler.hpp"
+#include "Prefab.hpp"
+#include "ComponentStorage.hpp"
+#include "View.hpp"
 
 /*!
  * @namespace jf
@@ -31,8 +42,15 @@ namespace jf {
         /*!
          * @class EntityManager
          * @brief A singleton managing the lifetime of entities
+         *
+         * Entities are constructed in place inside chunks, the entity with the id N sitting at the position N.
+         * Ids are small integers reused once their entity is destroyed, so the entities stay packed
+         * and finding an entity from its id is an array lookup.
          */
         class EntityManager final {
+        public:
+            static constexpr std::size_t entityChunkSize = 1024; /*!< The number of entities in a chunk */
+
         public:
 
             /*!
@@ -73,6 +91,32 @@ namespace jf {
              * @return An entity handler with the new entity
              */
             EntityHandler createEntity(const std::string &name);
+            /*!
+             * @brief Create several entities at once, each with a default constructed component of each given type
+             * @tparam Components The types of the components to assign to each entity (can be empty)
+             * @param count The number of entities to create
+             * @param name The name to give to the entities
+             * @return The ids of the new entities
+             *
+             * The memory of the entities and their components is allocated once for all the entities.
+             * An EntitiesCreatedEvent is emitted once all the entities have their components,
+             * the EntityCreatedEvent of each entity is emitted too if it has listeners.
+             */
+            template<typename... Components>
+            std::vector<internal::ID> createEntities(std::size_t count, const std::string &name);
+            /*!
+             * @brief Create entities by copying the components of the template of a prefab
+             * @param prefab The prefab to instantiate
+             * @param count The number of entities to create
+             * @return The ids of the new entities
+             * @throw jf::BadHandlerException if the template entity was destroyed
+             * @throw jf::ComponentNotCopyableException if a component of the template can not be copied
+             *
+             * The new entities are named like the template, enabled and not kept.
+             * The memory of the entities and their components is allocated once for all the entities.
+             * The events are emitted like in createEntities.
+             */
+            std::vector<internal::ID> instantiate(const Prefab &prefab, std::size_t count = 1);
             /*!
              * @brief Delete an entity given it's id
              * @param entityID The id of the entity to delete
@@ -80,16 +124,41 @@ namespace jf {
              */
             bool deleteEntity(const internal::ID &entityID);
             /*!
-             * @brief Delete an entity given it's id
+             * @brief Delete several entities at once
+             * @param entityIDs The ids of the entities to delete (each id must appear once)
+             * @return The number of entities that existed and were deleted
+             *
+             * An EntitiesDestroyedEvent listing the existing entities is emitted before they are destroyed,
+             * the EntityDestroyedEvent of each entity is emitted too.
+             */
+            std::size_t destroyEntities(const std::vector<internal::ID> &entityIDs);
+            /*!
+             * @brief Mark an entity to be deleted on the next call to applySafeDelete
              * @param entityID The id of the entity to delete
-             * @return true if the entity existed and was deleted false otherwise
+             *
+             * Can be called from several threads at once (e.g. from parallelApplyToEach)
              */
             void safeDeleteEntity(const internal::ID &entityID);
 
             /*!
              * @brief Delete all the existing entities except the ones marked as shouldBeKeeped
+             * @param releaseMemory Free the memory no longer used by the entities and the component storages,
+             * keep it (the default) when the memory will be needed again soon (loading the next level...)
+             *
+             * Runs in linear time: the entities are found in a single pass,
+             * then the components of each storage are destroyed in memory order and the entities in id order.
+             * An EntitiesDestroyedEvent listing the entities is emitted before any of them is destroyed,
+             * the EntityDestroyedEvent of each entity is emitted too if it has listeners.
+             * As with deleteEntity the handlers on an entity are invalid and it has no component left
+             * by the time its components are destroyed.
              */
-            void deleteAllEntities();
+            void deleteAllEntities(bool releaseMemory = false);
+
+            /*!
+             * @brief Allocate ahead the memory of the entities so that the given number of entities can live without any allocation
+             * @param count The number of entities
+             */
+            void reserve(std::size_t count);
 
             /*!
              * @brief Delete entities that have been marked for safe delete.
@@ -103,10 +172,13 @@ namespace jf {
              */
             EntityHandler getEntityByID(const internal::ID &entityID);
             /*!
-             * @brief Get the first entity with the matching name
+             * @brief Get an entity with the matching name
              * @param entityName The name of the entity to get
              * @param onlyEnabled Only get enabled entities
              * @return An EntityHandler to the requested entity (will be invalid if entity not found)
+             *
+             * The entities are indexed by name so this only looks at the entities with this name.
+             * When several entities match, which one is returned is unspecified.
              */
             EntityHandler getEntityByName(const std::string &entityName, bool onlyEnabled = true);
             /*!
@@ -114,9 +186,23 @@ namespace jf {
              * @param entityName The requested name
              * @param onlyEnabled Get only enabled entities
              * @return A vector of EntityHandle with the matching entities (empty vector if no entity is found)
+             *
+             * The entities are indexed by name so this only looks at the entities with this name, in no particular order.
              */
             std::vector<EntityHandler> getEntitiesByName(const std::string &entityName, bool onlyEnabled = true);
 
+            /*!
+             * @brief Get the view listing the entities having all the required components
+             * @tparam C The first required component
+             * @tparam Others The others required components (can be empty)
+             * @return A reference to the view
+             *
+             * The view is created on the first call and then kept up to date when components are assigned or removed.
+             * Do not store the returned reference.
+             */
+            template<typename C, typename... Others>
+            View<C, Others...> &view();
+
             /*!
              * @brief Get all entities having all the required components
              * @tparam C The first required component
@@ -144,47 +230,202 @@ namespace jf {
             template<typename C, typename... Others>
             void applyToEach(typename std::common_type<std::function<void(EntityHandler, components::ComponentHandler<C>, components::ComponentHandler<Others>...)>>::type func, bool onlyEnabled = true);
 
+            /*!
+             * @brief Apply a fuction/functor/lamda... to all entities with a specific set of components using the ThreadPool
+             * @tparam C The first required component
+             * @tparam Others The others required components (can be empty)
+             * @param func The function to apply, called concurrently from several threads
+             * @param onlyEnabled apply only to enabled entities
+             * @param grainSize The number of entities given to a thread at once
+             *
+             * See View::parallelApplyToEach for what func is allowed to do.
+             * The number of threads is set with ThreadPool::setThreadCount.
+             */
+            template<typename C, typename... Others>
+            void parallelApplyToEach(typename std::common_type<std::function<void(EntityHandler, components::ComponentHandler<C>, components::ComponentHandler<Others>...)>>::type func, bool onlyEnabled = true, std::size_t grainSize = 256);
+
+            /*!
+             * @brief Enable/disable an entity
+             * @param entityID The id of the entity
+             * @param enabled The value to set
+             *
+             * Does nothing if the entity does not exist.
+             * Not thread safe: do not call it from parallelApplyToEach.
+             */
+            void setEnable(const internal::ID &entityID, bool enabled);
+            /*!
+             * @brief Enable/disable several entities at once
+             * @param entityIDs The ids of the entities
+             * @param enabled The value to set
+             */
+            void setEnable(const std::vector<internal::ID> &entityIDs, bool enabled);
+            /*!
+             * @brief Get if an entity is enabled
+             * @param entityID The id of the entity
+             * @return true if the entity exists and is enabled false otherwise
+             */
+            bool isEnabled(const internal::ID &entityID) const
+            {
+                return _enabled.test(entityID.getID());
+            }
+
+            /*!
+             * @brief Get the current generation of an entity id
+             * @param entityID The id to get the generation of
+             * @return The generation of the id, incremented each time an entity with this id is destroyed
+             */
+            uint32_t getGeneration(const internal::ID &entityID) const;
+
+            /*!
+             * @brief Method used internally by handlers to get an entity if it still exists
+             * @param entityID The id of the entity
+             * @param generation The generation of the id known by the handler
+             * @return The entity or nullptr if the entity was destroyed or the generation does not match
+             */
+            Entity *getEntityPointer(const internal::ID &entityID, uint32_t generation) const
+            {
+                uint64_t index = entityID.getID();
+                if (index >= _slots.size() || _slots[index].first != generation)
+                    return nullptr;
+                return _slots[index].second;
+            }
+
+            /*!
+             * @brief Method used internally by entities to update the views when one of their components changed
+             * @param entity The entity that changed
+             * @param type The type of the assigned or removed component
+             */
+            void onComponentChanged(Entity &entity, const std::type_index &type);
+
         private:
             /*!
              * @brief Internal function used to register a new entity
              * @param entity The entity to register
              */
             void registerNewEntity(Entity *entity);
+            /*!
+             * @brief Construct a new entity with the first free id and register it without emitting any event
+             * @param nameID The interned name to give to the entity
+             * @return The new entity
+             */
+            Entity *constructEntity(uint32_t nameID);
+            /*!
+             * @brief Emit the events of entities created by createEntities
+             * @param entityIDs The ids of the created entities
+             */
+            void notifyEntitiesCreated(const std::vector<internal::ID> &entityIDs);
+            /*!
+             * @brief Get the memory of the entity with a given id, allocate it if needed
+             * @param entityID The id of the entity
+             * @return The memory where the entity can be constructed
+             */
+            void *getEntityMemory(const internal::ID &entityID);
             /*!
              * @brief Unregister an entity by it's ID
              * @param entityID The ID of the entity to unregister
              * @return true if the entity existed false otherwise
              */
             bool unregisterEntity(const internal::ID &entityID);
+            /*!
+             * @brief Remove an entity from the indexes, destroy it and free its id (it must already be removed from the views)
+             * @param entity The registered entity to destroy
+             */
+            void releaseEntity(Entity *entity);
+            /*!
+             * @brief Remove an entity from the indexes and invalidate its handlers without destroying it
+             * @param entity The registered entity to unregister
+             */
+            void detachEntity(Entity *entity);
+            /*!
+             * @brief Free the chunks of entities that hold no living entity
+             */
+            void releaseEntityMemory();
+            /*!
+             * @brief Add an entity to the list of the entities with its name
+             * @param entity The entity to add
+             */
+            void indexName(Entity *entity);
+            /*!
+             * @brief Remove an entity from the list of the entities with its name
+             * @param entity The entity to remove
+             */
+            void unindexName(Entity *entity);
 
         private:
+            /*!
+             * @brief The memory of an entity
+             */
+            using EntityMemory = typename std::aligned_storage<sizeof(Entity), alignof(Entity)>::type;
+
             uint64_t _maxId; /*!< The last biggest existing entity */
-            std::unordered_map<internal::ID, Entity *> _entities; /*!< A map containing all the existing entities */
+            std::vector<std::unique_ptr<EntityMemory[]>> _chunks; /*!< The chunks holding the entities, indexed by id / entityChunkSize */
+            std::vector<std::pair<uint32_t, Entity *>> _slots; /*!< For each entity id its generation and its entity (nullptr if none) */
             std::queue<internal::ID> _freeIDs; /*!< Ids destroyed and not used */
+            std::vector<std::vector<uint64_t>> _entitiesByName; /*!< The ids of the existing entities of each name, indexed by name id */
+            std::vector<std::size_t> _namePositions; /*!< For each entity id the position of the entity in the list of its name */
+            internal::DynamicBitset _enabled; /*!< For each entity id if the entity exists and is enabled */
             std::vector<internal::ID> _toDestroyIDs; /*!< Ids of entities to destroy */
+            std::mutex _toDestroyMutex; /*!< Mutex protecting _toDestroyIDs */
+            std::unordered_map<std::type_index, BaseView *> _views; /*!< The existing views by type of view */
+            std::mutex _viewsMutex; /*!< Mutex protecting the creation of views (systems may get views concurrently) */
+            std::unordered_map<std::type_index, std::vector<BaseView *>> _viewsByComponent; /*!< The views watching each component type */
         };
 
         template<typename C, typename... Others>
-        std::vector<entities::EntityHandler> entities::EntityManager::getEntitiesWith(bool onlyEnabled)
+        View<C, Others...> &entities::EntityManager::view()
         {
-            std::vector<entities::EntityHandler> matching;
-            for (auto &i : _entities) {
-                if (i.second->hasComponents<C, Others...>() && (i.second->isEnabled() || !onlyEnabled)) {
-                    matching.emplace_back(i.second);
-                }
+            std::lock_guard<std::mutex> lock(_viewsMutex);
+            auto existing = _views.find(internal::getTypeIndex<View<C, Others...>>());
+            if (existing != _views.end())
+                return *static_cast<View<C, Others...> *>(existing->second);
+            auto *newView = new View<C, Others...>(_enabled);
+            _views.insert(std::make_pair(internal::getTypeIndex<View<C, Others...>>(), newView));
+            for (auto &type : newView->getTypes())
+                _viewsByComponent[type].push_back(newView);
+            components::ComponentStorage<C>::getInstance().forEach([newView](Entity &entity, C &) {
+                newView->update(entity);
+            });
+            return *newView;
+        }
+
+        template<typename... Components>
+        std::vector<internal::ID> entities::EntityManager::createEntities(std::size_t count, const std::string &name)
+        {
+            reserve(_maxId - _freeIDs.size() + count);
+            (void)std::initializer_list<int>{(components::ComponentStorage<Components>::getInstance().reserve(
+                components::ComponentStorage<Components>::getInstance().size() + count), 0)...};
+            auto &names = internal::NameTable::getInstance();
+            uint32_t nameID = names.intern(name);
+            std::vector<internal::ID> entityIDs;
+            entityIDs.reserve(count);
+            for (std::size_t i = 0; i < count; ++i) {
+                Entity *entity = constructEntity(nameID);
+                (void)std::initializer_list<int>{(entity->assignComponent<Components>(), 0)...};
+                entityIDs.push_back(entity->getID());
             }
-            return matching;
+            names.release(nameID);
+            notifyEntitiesCreated(entityIDs);
+            return entityIDs;
+        }
+
+        template<typename C, typename... Others>
+        std::vector<entities::EntityHandler> entities::EntityManager::getEntitiesWith(bool onlyEnabled)
+        {
+            return view<C, Others...>().getEntities(onlyEnabled);
         }
 
         template<typename C, typename... Others>
         void entities::EntityManager::applyToEach(
             typename std::common_type<std::function<void(EntityHandler, components::ComponentHandler<C>, components::ComponentHandler<Others>...)>>::type func, bool onlyEnabled)
         {
-            for (auto &entity : _entities) {
-                if (entity.second->hasComponents<C, Others...>() && (entity.second->isEnabled() || !onlyEnabled)) {
-                    func(EntityHandler(entity.second), entity.second->getComponent<C>(), entity.second->getComponent<Others>()...);
-                }
-            }
+            view<C, Others...>().applyToEach(func, onlyEnabled);
+        }
+
+        template<typename C, typename... Others>
+        void entities::EntityManager::parallelApplyToEach(
+            typename std::common_type<std::function<void(EntityHandler, components::ComponentHandler<C>, components::ComponentHandler<Others>...)>>::type func, bool onlyEnabled, std::size_t grainSize)
+        {
+            view<C, Others...>().parallelApplyToEach(func, onlyEnabled, grainSize);
         }
     }
 }
@@ -9,18 +9,14 @@
 
 #include "EventManager.hpp"
 
-jf::events::EventManager::EventManager(): _freeIDs(), _maxID(0), _listeners()
+jf::events::EventManager::EventManager(): _listeners(), _queuedTypes(), _posted(), _postedMutex()
 {
 
 }
 
 jf::events::EventManager::~EventManager()
 {
-    for (auto &vec : _listeners) {
-        for (auto &listener : vec.second) {
-            delete listener;
-        }
-    }
+
 }
 
 jf::events::EventManager &jf::events::EventManager::getInstance()
@@ -29,29 +25,24 @@ jf::events::EventManager &jf::events::EventManager::getInstance()
     return instance;
 }
 
-uint64_t jf::events::EventManager::getNextID()
+void jf::events::EventManager::dispatchQueued()
 {
-    if (_freeIDs.empty()) {
-        _maxID++;
-        return _maxID;
-    } else {
-        internal::ID id = _freeIDs.front();
-        _freeIDs.pop();
-        return id.getID();
+    std::vector<BasePostedEvents *> posted;
+    {
+        std::lock_guard<std::mutex> lock(_postedMutex);
+        for (auto &events : _posted)
+            posted.push_back(events.get());
+    }
+    for (auto *events : posted)
+        events->emitPosted();
+    std::vector<std::size_t> types;
+    types.swap(_queuedTypes);
+    for (std::size_t i = 0; i < types.size(); ++i) {
+        try {
+            _listeners[types[i]]->dispatchQueued();
+        } catch (...) {
+            _queuedTypes.insert(_queuedTypes.begin(), types.begin() + i + 1, types.end());
+            throw;
+        }
     }
-}
-
-jf::events::BaseListener::BaseListener(const jf::internal::ID &id): _id(id)
-{
-
-}
-
-bool jf::events::BaseListener::operator==(const jf::internal::ID &id)
-{
-    return _id == id;
-}
-
-const jf::internal::ID &jf::events::BaseListener::getID() const
-{
-    return _id;
 }
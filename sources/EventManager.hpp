@@ -10,15 +10,24 @@
 #ifndef JFENTITYCOMPONENTSYSTEM_EVENTMANAGER_HPP
 #define JFENTITYCOMPONENTSYSTEM_EVENTMANAGER_HPP
 
-#include <queue>
+#include <cstdint>
+#include <functional>
 #include <iostream>
-#include <vector>
+#include <memory>
+#include <mutex>
+#include <type_traits>
 #include <unordered_map>
+#include <vector>
 #include "Internal.hpp"
 #include "ID.hpp"
+#include "MPSCQueue.hpp"
 
-#define EMIT_CREATE(T) (jf::events::EventManager::getInstance().emit<jf::events::ComponentCreatedEvent<T>>({jf::components::ComponentHandler<T>(this)}))
-#define EMIT_DELETE(T) (jf::events::EventManager::getInstance().emit<jf::events::ComponentDestroyedEvent<T>>({this}))
+#define EMIT_CREATE(T) (jf::components::LifecycleEvents<T>::value \
+    && jf::events::EventManager::getInstance().hasListeners<jf::events::ComponentCreatedEvent<T>>() \
+    ? jf::events::EventManager::getInstance().emit<jf::events::ComponentCreatedEvent<T>>({jf::components::ComponentHandler<T>(this)}) : void())
+#define EMIT_DELETE(T) (jf::components::LifecycleEvents<T>::value \
+    && jf::events::EventManager::getInstance().hasListeners<jf::events::ComponentDestroyedEvent<T>>() \
+    ? jf::events::EventManager::getInstance().emit<jf::events::ComponentDestroyedEvent<T>>({this}) : void())
 
 /*!
  * @namespace jf
@@ -32,93 +41,536 @@ namespace jf {
      */
     namespace events {
 
+        struct EntityDestroyedEvent;
+
+        template<typename T>
+        struct ComponentDestroyedEvent;
+
+        /*!
+         * @struct Queueable
+         * @brief A trait telling if the events of a type can be queued (see EventManager::setQueued) or posted
+         * @tparam EventType The type of the event
+         *
+         * EntityDestroyedEvent and ComponentDestroyedEvent hold a pointer to an object being destroyed,
+         * it would be freed before the queued event is dispatched so they can only be emitted right away.
+         */
+        template<typename EventType>
+        struct Queueable : std::true_type {};
+
+        template<>
+        struct Queueable<EntityDestroyedEvent> : std::false_type {};
+
+        template<typename T>
+        struct Queueable<ComponentDestroyedEvent<T>> : std::false_type {};
+
         /*!
-         * @class BaseListener
-         * @brief A class used internaly to store EventListeners
+         * @class EventSpan
+         * @brief A view on contiguous events given to batch listeners
+         * @tparam EventType The type of the events
          */
-        class BaseListener {
+        template<typename EventType>
+        class EventSpan final {
         public:
             /*!
              * @brief ctor
-             * @param id The ID to set to this Listener
+             * @param events A pointer to the first event
+             * @param count The number of events
+             */
+            EventSpan(const EventType *events, std::size_t count)
+                : _events(events), _count(count)
+            {}
+
+            /*!
+             * @brief Get the first event
+             * @return A pointer to the first event
              */
-            explicit BaseListener(const internal::ID &id);
+            const EventType *begin() const
+            {
+                return _events;
+            }
+
+            /*!
+             * @brief Get the end of the events
+             * @return A pointer past the last event
+             */
+            const EventType *end() const
+            {
+                return _events + _count;
+            }
+
+            /*!
+             * @brief Get the number of events
+             * @return The number of events
+             */
+            std::size_t size() const
+            {
+                return _count;
+            }
+
+            /*!
+             * @brief Get an event
+             * @param index The index of the event
+             * @return A reference to the event
+             */
+            const EventType &operator[](std::size_t index) const
+            {
+                return _events[index];
+            }
+
+        private:
+            const EventType *_events; /*!< The first event */
+            std::size_t _count; /*!< The number of events */
+        };
+
+        /*!
+         * @class BaseListenerList
+         * @brief A class used internaly to store the ListenerLists of all event types
+         */
+        class BaseListenerList {
+        public:
             /*!
              * @brief dtor
              */
-            virtual ~BaseListener() = default;
+            virtual ~BaseListenerList() = default;
+
+            /*!
+             * @brief Remove a listener by it's ID
+             * @param id The id of the listener to remove
+             */
+            virtual void remove(const internal::ID &id) = 0;
 
             /*!
-             * @brief equality operator
-             * @param id The id to compare to
-             * @return true if the id match false otherwise
+             * @brief Send the queued events to the listeners and empty the queue
+             *
+             * Events queued while dispatching stay in the queue for the next dispatch
              */
-            bool operator==(const internal::ID &id);
+            virtual void dispatchQueued() = 0;
 
             /*!
-             * @brief Get the id of this listener
-             * @return The id of this listener
+             * @brief Get the dense id of the event type of a listener
+             * @param id The id of the listener
+             * @return The dense id of the event type (out of range for an invalid id)
              */
-            const internal::ID &getID() const;
-        protected:
-            internal::ID _id; /*!< The id of the listener */
+            static std::size_t getEventType(const internal::ID &id)
+            {
+                return static_cast<std::size_t>(id.getID() >> 48) - 1;
+            }
         };
 
         /*!
-         * @class EventListener
-         * @brief A class used internaly to manage events and callbacks
-         * @tparam RegistererType The type of the register
-         * @tparam EventType The type of the event to register to
+         * @class ListenerList
+         * @brief A class used internaly to store the listeners of an event type contiguously
+         * @tparam EventType The type of the event the listeners registered to
+         *
+         * A listener id holds the dense id of the event type (16 bits), the generation of its slot (16 bits)
+         * and its slot (32 bits). The slot gives the position of the listener so removing it does not need any search.
+         * A slot whose generation reaches its last value is never reused, so an old id can never remove a newer listener.
+         * Removing a listener moves the last listener in its place, so the order of the listeners is not kept.
+         * Listeners added while an event is emitted are kept apart and only receive the next events.
+         * Listeners removed while an event is emitted are marked and erased once the emit is over.
+         *
+         * Listeners of a single event and batch listeners are stored apart so that emitting an event
+         * makes a single call per listener. Batch listeners receive the events as an EventSpan.
+         * Queued events are stored in a vector reused from one dispatch to the next.
          */
-        template<typename RegistererType, typename EventType>
-        class EventListener final : public BaseListener {
+        template<typename EventType>
+        class ListenerList final : public BaseListenerList {
+        public:
+            using Callback = std::function<void(const EventType &)>; /*!< The callback of a listener of single events */
+            using BatchCallback = std::function<void(EventSpan<EventType>)>; /*!< The callback of a batch listener */
+
         public:
             /*!
              * @brief ctor
-             * @param id The id to set this listener to
-             * @param registerer The registerer of this listener
-             * @param callback The callback to send when the EnventType event is emitted
+             * @param eventType The dense id of the event type
              */
-            EventListener(const internal::ID &id, RegistererType *registerer,
-                typename std::common_type<std::function<void(RegistererType *, EventType)>>::type callback)
-                : BaseListener(id), _registerer(registerer), _callback(callback)
+            explicit ListenerList(std::size_t eventType)
+                : _eventType(eventType), _listeners(), _batchListeners(), _slots(), _freeSlots(), _emitting(0), _tombstones(0),
+                _queued(false), _queue(), _coalescingKey(), _coalesced()
             {}
 
+            /*!
+             * @brief dtor
+             */
+            ~ListenerList() override = default;
+
+            /*!
+             * @brief Add a listener called once for each event
+             * @param callback The callback to call when an event is emitted
+             * @return The id of the listener
+             */
+            internal::ID add(Callback callback)
+            {
+                return add(_listeners, std::move(callback), false);
+            }
+
+            /*!
+             * @brief Add a listener called with all the events of an emit or a dispatch at once
+             * @param callback The callback to call when events are emitted
+             * @return The id of the listener
+             */
+            internal::ID addBatch(BatchCallback callback)
+            {
+                return add(_batchListeners, std::move(callback), true);
+            }
+
+            /*!
+             * @brief Remove a listener by it's ID, do nothing if it does not exist anymore
+             * @param id The id of the listener to remove
+             */
+            void remove(const internal::ID &id) override
+            {
+                uint32_t slot = static_cast<uint32_t>(id.getID());
+                if (slot >= _slots.size() || _slots[slot].generation != static_cast<uint16_t>(id.getID() >> 32))
+                    return;
+                Slot removed = _slots[slot];
+                if (++_slots[slot].generation != retiredGeneration)
+                    _freeSlots.push_back(slot);
+                if (removed.batch)
+                    remove(_batchListeners, removed);
+                else
+                    remove(_listeners, removed);
+            }
+
+            /*!
+             * @brief Send an event to all the listeners
+             * @param event The event to send
+             */
+            void emit(const EventType &event)
+            {
+                ++_emitting;
+                try {
+                    for (std::size_t i = 0; i < _listeners.active.size(); ++i) {
+                        if (_listeners.active[i].id.isValid())
+                            _listeners.active[i].callback(event);
+                    }
+                    for (std::size_t i = 0; i < _batchListeners.active.size(); ++i) {
+                        if (_batchListeners.active[i].id.isValid())
+                            _batchListeners.active[i].callback(EventSpan<EventType>(&event, 1));
+                    }
+                } catch (...) {
+                    endEmit();
+                    throw;
+                }
+                endEmit();
+            }
+
+            /*!
+             * @brief Send events to all the listeners
+             * @param events The events to send
+             *
+             * Each listener of single events receives all the events before the next listener
+             */
+            void emit(EventSpan<EventType> events)
+            {
+                ++_emitting;
+                try {
+                    for (std::size_t i = 0; i < _listeners.active.size(); ++i) {
+                        for (std::size_t j = 0; j < events.size() && _listeners.active[i].id.isValid(); ++j)
+                            _listeners.active[i].callback(events[j]);
+                    }
+                    for (std::size_t i = 0; i < _batchListeners.active.size(); ++i) {
+                        if (_batchListeners.active[i].id.isValid())
+                            _batchListeners.active[i].callback(events);
+                    }
+                } catch (...) {
+                    endEmit();
+                    throw;
+                }
+                endEmit();
+            }
+
+            /*!
+             * @brief Get if an emitted event would be used
+             * @return true if there is at least one listener or if the events are queued
+             */
+            bool hasListeners() const
+            {
+                return !_listeners.active.empty() || !_listeners.pending.empty()
+                    || !_batchListeners.active.empty() || !_batchListeners.pending.empty() || _queued;
+            }
+
+            /*!
+             * @brief Get if the emitted events are queued
+             * @return true if the events are queued false if they are sent right away
+             */
+            bool isQueued() const
+            {
+                return _queued;
+            }
+
+            /*!
+             * @brief Set if the emitted events are queued
+             * @param queued true to queue the events false to send them right away
+             */
+            void setQueued(bool queued)
+            {
+                _queued = queued;
+            }
+
+            /*!
+             * @brief Set the function used to merge the queued events
+             * @param key A function giving a key to an event, nullptr to keep every event
+             *
+             * When an event is queued while an event with the same key is already queued,
+             * the new event replaces the old one in the queue
+             */
+            void setCoalescing(std::function<uint64_t(const EventType &)> key)
+            {
+                _coalescingKey = std::move(key);
+                _coalesced.clear();
+            }
+
+            /*!
+             * @brief Add an event to the queue
+             * @param event The event to queue
+             * @return true if the queue was empty
+             */
+            bool enqueue(const EventType &event)
+            {
+                bool wasEmpty = _queue.empty();
+                if (_coalescingKey) {
+                    auto inserted = _coalesced.insert(std::make_pair(_coalescingKey(event), _queue.size()));
+                    if (!inserted.second) {
+                        _queue[inserted.first->second] = event;
+                        return wasEmpty;
+                    }
+                }
+                _queue.push_back(event);
+                return wasEmpty;
+            }
+
+            /*!
+             * @brief Send the queued events to the listeners and empty the queue
+             *
+             * Events queued while dispatching stay in the queue for the next dispatch
+             */
+            void dispatchQueued() override
+            {
+                std::vector<EventType> events;
+                events.swap(_queue);
+                _coalesced.clear();
+                try {
+                    emit(EventSpan<EventType>(events.data(), events.size()));
+                } catch (...) {
+                    recycle(events);
+                    throw;
+                }
+                recycle(events);
+            }
+
+        private:
+            /*!
+             * @brief Give back the memory of dispatched events to the queue if nothing was queued since
+             * @param events The dispatched events
+             */
+            void recycle(std::vector<EventType> &events)
+            {
+                if (!_queue.empty())
+                    return;
+                events.clear();
+                _queue.swap(events);
+            }
+
+            /*!
+             * @brief End an emit, if it was the last one running erase the removed listeners and add the pending ones
+             */
+            void endEmit()
+            {
+                if (--_emitting != 0 || (_tombstones == 0 && _listeners.pending.empty() && _batchListeners.pending.empty()))
+                    return;
+                pack(_listeners);
+                pack(_batchListeners);
+                _tombstones = 0;
+            }
+
+        private:
+            /*!
+             * @struct Listener
+             * @brief A registered callback
+             * @tparam CallbackType The type of the callback
+             */
+            template<typename CallbackType>
+            struct Listener {
+                internal::ID id; /*!< The id of the listener, invalid if removed during an emit */
+                CallbackType callback; /*!< The function callback */
+            };
+
+            /*!
+             * @struct Listeners
+             * @brief The listeners of a kind
+             * @tparam CallbackType The type of the callbacks
+             */
+            template<typename CallbackType>
+            struct Listeners {
+                std::vector<Listener<CallbackType>> active; /*!< The listeners receiving the events */
+                std::vector<Listener<CallbackType>> pending; /*!< The listeners added during an emit */
+            };
+
+            static constexpr uint16_t retiredGeneration = UINT16_MAX; /*!< The generation of the slots never reused, no id carries it */
+
+            /*!
+             * @struct Slot
+             * @brief Where to find a listener from its id
+             */
+            struct Slot {
+                std::size_t position = 0; /*!< The position of the listener in its active or pending listeners */
+                uint16_t generation = 0; /*!< Incremented each time the listener of the slot is removed (retiredGeneration once retired) */
+                bool pending = false; /*!< true if the listener is in the pending listeners */
+                bool batch = false; /*!< true if the listener is a batch listener */
+            };
+
+            /*!
+             * @brief Add a listener
+             * @tparam CallbackType The type of the callback
+             * @param listeners The listeners of the kind of the new one
+             * @param callback The callback of the listener
+             * @param batch true for a batch listener
+             * @return The id of the listener
+             */
+            template<typename CallbackType>
+            internal::ID add(Listeners<CallbackType> &listeners, CallbackType callback, bool batch)
+            {
+                uint32_t slot;
+                if (_freeSlots.empty()) {
+                    slot = static_cast<uint32_t>(_slots.size());
+                    _slots.emplace_back();
+                } else {
+                    slot = _freeSlots.back();
+                    _freeSlots.pop_back();
+                }
+                internal::ID id((static_cast<uint64_t>(_eventType + 1) << 48)
+                    | (static_cast<uint64_t>(_slots[slot].generation) << 32) | slot);
+                auto &list = _emitting != 0 ? listeners.pending : listeners.active;
+                _slots[slot].position = list.size();
+                _slots[slot].pending = _emitting != 0;
+                _slots[slot].batch = batch;
+                list.push_back({id, std::move(callback)});
+                return id;
+            }
+
+            /*!
+             * @brief Remove a listener from its list, or mark it if an emit is running
+             * @tparam CallbackType The type of the callback
+             * @param listeners The listeners of the kind of the removed one
+             * @param removed The slot of the removed listener
+             */
+            template<typename CallbackType>
+            void remove(Listeners<CallbackType> &listeners, const Slot &removed)
+            {
+                auto &list = removed.pending ? listeners.pending : listeners.active;
+                if (_emitting != 0) {
+                    list[removed.position].id = internal::ID();
+                    ++_tombstones;
+                    return;
+                }
+                if (removed.position != list.size() - 1) {
+                    list[removed.position] = std::move(list.back());
+                    _slots[static_cast<uint32_t>(list[removed.position].id.getID())].position = removed.position;
+                }
+                list.pop_back();
+            }
+
+            /*!
+             * @brief Erase the listeners removed during an emit and add the pending ones
+             * @tparam CallbackType The type of the callback
+             * @param listeners The listeners to pack
+             */
+            template<typename CallbackType>
+            void pack(Listeners<CallbackType> &listeners)
+            {
+                auto &active = listeners.active;
+                std::size_t packed = 0;
+                for (std::size_t i = 0; i < active.size(); ++i) {
+                    if (!active[i].id.isValid())
+                        continue;
+                    if (packed != i)
+                        active[packed] = std::move(active[i]);
+                    _slots[static_cast<uint32_t>(active[packed].id.getID())].position = packed;
+                    ++packed;
+                }
+                active.resize(packed);
+                for (auto &listener : listeners.pending) {
+                    if (!listener.id.isValid())
+                        continue;
+                    Slot &slot = _slots[static_cast<uint32_t>(listener.id.getID())];
+                    slot.position = active.size();
+                    slot.pending = false;
+                    active.push_back(std::move(listener));
+                }
+                listeners.pending.clear();
+            }
+
+            std::size_t _eventType; /*!< The dense id of the event type */
+            Listeners<Callback> _listeners; /*!< The listeners called once for each event */
+            Listeners<BatchCallback> _batchListeners; /*!< The listeners called with all the events at once */
+            std::vector<Slot> _slots; /*!< The slot of each listener id */
+            std::vector<uint32_t> _freeSlots; /*!< The slots not used by any listener */
+            std::size_t _emitting; /*!< The number of emits currently running */
+            std::size_t _tombstones; /*!< The number of listeners removed during an emit */
+            bool _queued; /*!< true if the emitted events are queued */
+            std::vector<EventType> _queue; /*!< The events waiting for the next dispatch */
+            std::function<uint64_t(const EventType &)> _coalescingKey; /*!< The key used to merge queued events (empty if none) */
+            std::unordered_map<uint64_t, std::size_t> _coalesced; /*!< The position in the queue of the events of each key */
+        };
+
+        /*!
+         * @class BasePostedEvents
+         * @brief A class used internaly to store the events posted from other threads for all event types
+         */
+        class BasePostedEvents {
+        public:
+            /*!
+             * @brief dtor
+             */
+            virtual ~BasePostedEvents() = default;
+
+            /*!
+             * @brief Emit the events posted before the call, must only be called by one thread at a time
+             */
+            virtual void emitPosted() = 0;
+        };
+
+        /*!
+         * @class PostedEvents
+         * @brief A class used internaly to store the events of a type posted from other threads
+         * @tparam EventType The type of the posted events
+         */
+        template<typename EventType>
+        class PostedEvents final : public BasePostedEvents {
+        public:
             /*!
              * @brief ctor
-             * @param other The listener to cpy
              */
-            EventListener(const EventListener<RegistererType, EventType> &other)
-            : BaseListener(other._id), _registerer(other._registerer), _callback(other._callback)
+            PostedEvents()
+                : _queue(), _count(0)
             {}
 
             /*!
              * @brief dtor
              */
-            ~EventListener() override = default;
+            ~PostedEvents() override = default;
 
             /*!
-             * @brief Method used to receive an event and trigger a callback
-             * @param event The received event
+             * @brief Add an event to the queue, can be called from any thread without blocking
+             * @param event The event to post
              */
-            void receive(const EventType &event)
+            void post(const EventType &event)
             {
-                _callback(_registerer, event);
+                _queue.push(event);
+                _count.fetch_add(1, std::memory_order_release);
             }
 
             /*!
-             * @brief equality operator
-             * @param listener The listener to compare to
-             * @return true if the ids are the same false otherwise
+             * @brief Emit the events posted before the call, must only be called by one thread at a time
+             *
+             * Events posted during the call are left for the next one so busy producers can not hold the consumer
              */
-            bool operator==(const EventListener<RegistererType, EventType> &listener)
-            {
-                return _id == listener._id;
-            }
+            void emitPosted() override;
 
         private:
-            RegistererType *_registerer; /*!< The registerer of this event */
-            std::function<void(RegistererType *, EventType)> _callback; /*!< The function callback */
+            internal::MPSCQueue<EventType> _queue; /*!< The posted events */
+            std::atomic<std::size_t> _count; /*!< The number of events in the queue */
         };
 
         /*!
@@ -158,75 +610,216 @@ namespace jf {
 
         public:
             /*!
-             * @brief Get the next id to use for the next listener
-             * @return The next id to use
+             * @brief Add a new listener that will trigger a callback with the event and the registerer on a given event
+             * @tparam RegistererType The type of the registerer
+             * @tparam EventType The type of the event to register to
+             * @tparam Callback The type of the callback (void(RegistererType *, EventType)), deduced
+             * @param registerer A pointer to the registerer
+             * @param callback The callback to trigger
+             * @return The id of the created listener
+             *
+             * The callback is stored as is next to the registerer so that an emit makes a single call per listener
              */
-            uint64_t getNextID();
+            template<typename RegistererType, typename EventType, typename Callback>
+            internal::ID addListener(RegistererType *registerer, Callback callback)
+            {
+                return getListenerList<EventType>().add([registerer, callback = std::move(callback)](const EventType &event)
+                    noexcept(noexcept(callback(registerer, event))) {
+                    callback(registerer, event);
+                });
+            }
 
             /*!
-             * @brief Add a new listener that will trigger a callback with the event and the registerer on a given event
+             * @brief Add a new listener that will trigger a callback with all the events dispatched at once
              * @tparam RegistererType The type of the registerer
              * @tparam EventType The type of the event to register to
+             * @tparam Callback The type of the callback (void(RegistererType *, EventSpan<EventType>)), deduced
              * @param registerer A pointer to the registerer
              * @param callback The callback to trigger
-             * @return The id of the created listener
+             * @return The id of the created listener (removed with removeListener)
+             *
+             * The callback gets all the queued events of a dispatch in a single EventSpan,
+             * or a span of one event for events emitted while the event type is not queued
              */
-            template<typename RegistererType, typename EventType>
-            internal::ID addListener(RegistererType *registerer,
-                typename std::common_type<std::function<void(RegistererType *, EventType)>>::type callback)
-            {
-                internal::ID id(getNextID());
-                auto *listener = new EventListener<RegistererType, EventType>(id, registerer, callback);
-                auto existing = _listeners.find(internal::getTypeIndex<EventType>());
-                if (existing == _listeners.end()) {
-                    std::vector<BaseListener *> newVec;
-                    newVec.push_back(listener);
-                    _listeners.insert(std::make_pair(internal::getTypeIndex<EventType>(), newVec));
-                } else {
-                    existing->second.push_back(listener);
-                }
-                return id;
+            template<typename RegistererType, typename EventType, typename Callback>
+            internal::ID addBatchListener(RegistererType *registerer, Callback callback)
+            {
+                return getListenerList<EventType>().addBatch([registerer, callback = std::move(callback)](EventSpan<EventType> events)
+                    noexcept(noexcept(callback(registerer, events))) {
+                    callback(registerer, events);
+                });
             }
 
             /*!
              * @brief Remove a listener by it's ID
              * @param id The id of the listener to remove
+             *
+             * Runs in constant time and can be called from a callback, even to remove the listener being called
              */
             void removeListener(const internal::ID &id)
             {
-                for (auto &vec : _listeners) {
-                    for (auto it = vec.second.begin(); it != vec.second.end(); it++) {
-                        if ((*it)->getID() == id) {
-                            delete (*it);
-                            vec.second.erase(it);
-                            _freeIDs.emplace(id);
-                            return;
-                        }
-                    }
-                }
+                std::size_t type = BaseListenerList::getEventType(id);
+                if (type < _listeners.size() && _listeners[type])
+                    _listeners[type]->remove(id);
             }
 
             /*!
              * @brief Emit a given event and trigger all the listeners that register to this event
              * @tparam EventType The type of the event to emit
              * @param event The event to emit
+             *
+             * If the event type is queued (see setQueued) the event is queued instead
              */
             template<typename EventType>
             void emit(const EventType &event)
             {
-                auto vec = _listeners.find(internal::getTypeIndex<EventType>());
-                if (vec != _listeners.end()) {
-                    for (auto &listener : vec->second) {
-                        reinterpret_cast<EventListener<void, EventType>*>(listener)->receive(event);
-                    }
+                std::size_t type = internal::getDenseTypeID<BaseListenerList, EventType>();
+                if (type >= _listeners.size() || !_listeners[type])
+                    return;
+                auto *list = static_cast<ListenerList<EventType> *>(_listeners[type].get());
+                if (list->isQueued()) {
+                    if (list->enqueue(event))
+                        _queuedTypes.push_back(type);
+                    return;
                 }
+                list->emit(event);
+            }
+
+            /*!
+             * @brief Get if emitting an event would do anything, used to skip building events nobody listens to
+             * @tparam EventType The type of the event
+             * @return true if there is at least one listener of the event type or if the event type is queued
+             */
+            template<typename EventType>
+            bool hasListeners() const
+            {
+                std::size_t type = internal::getDenseTypeID<BaseListenerList, EventType>();
+                return type < _listeners.size() && _listeners[type]
+                    && static_cast<const ListenerList<EventType> *>(_listeners[type].get())->hasListeners();
+            }
+
+            /*!
+             * @brief Queue an event, it will be sent to the listeners on the next call to dispatchQueued
+             * @tparam EventType The type of the event to queue
+             * @param event The event to queue
+             */
+            template<typename EventType>
+            void enqueue(const EventType &event)
+            {
+                static_assert(Queueable<EventType>::value, "This event points to an object destroyed before the queued events are dispatched");
+                if (getListenerList<EventType>().enqueue(event))
+                    _queuedTypes.push_back(internal::getDenseTypeID<BaseListenerList, EventType>());
+            }
+
+            /*!
+             * @brief Set if the emitted events of a type are queued instead of being sent right away
+             * @tparam EventType The type of the event
+             * @param queued true to queue the events, false to send them right away
+             *
+             * Queued events are sent in order by dispatchQueued, called at the start of each SystemManager::tick.
+             * Event types that are not Queueable (EntityDestroyedEvent, ComponentDestroyedEvent) do not compile.
+             */
+            template<typename EventType>
+            void setQueued(bool queued = true)
+            {
+                static_assert(Queueable<EventType>::value, "This event points to an object destroyed before the queued events are dispatched");
+                getListenerList<EventType>().setQueued(queued);
+            }
+
+            /*!
+             * @brief Merge the queued events of a type having the same key
+             * @tparam EventType The type of the event
+             * @param key A function giving a key to an event, nullptr to keep every queued event
+             *
+             * An event queued while an event with the same key is waiting replaces it (at the position of the old one)
+             */
+            template<typename EventType>
+            void setCoalescing(std::function<uint64_t(const EventType &)> key)
+            {
+                getListenerList<EventType>().setCoalescing(std::move(key));
+            }
+
+            /*!
+             * @brief Post an event from any thread, it will be emitted on the next call to dispatchQueued
+             * @tparam EventType The type of the event to post
+             * @param event The event to post
+             *
+             * Thread safe and lock-free (except for the first post of each event type), the event is
+             * pushed on a queue of its type without waiting for the thread dispatching the events.
+             * The events of a type posted from a single thread are emitted in order.
+             */
+            template<typename EventType>
+            void post(const EventType &event)
+            {
+                static_assert(Queueable<EventType>::value, "This event points to an object destroyed before the queued events are dispatched");
+                static PostedEvents<EventType> &posted = addPostedEvents<EventType>();
+                posted.post(event);
+            }
+
+            /*!
+             * @brief Emit the events posted from other threads then send all the queued events to their listeners
+             *
+             * Event types are dispatched in the order they were first queued.
+             * Events queued by the listeners during the dispatch are kept for the next one.
+             * Must only be called from the thread owning the ecs (the one calling SystemManager::tick).
+             */
+            void dispatchQueued();
+
+        private:
+            /*!
+             * @brief Create the queue of the events of a type posted from other threads
+             * @tparam EventType The type of the event
+             * @return A reference to the queue, kept alive as long as the manager
+             */
+            template<typename EventType>
+            PostedEvents<EventType> &addPostedEvents()
+            {
+                auto *posted = new PostedEvents<EventType>();
+                std::lock_guard<std::mutex> lock(_postedMutex);
+                _posted.emplace_back(posted);
+                return *posted;
+            }
+
+            /*!
+             * @brief Get the list of listeners of an event type, create it if needed
+             * @tparam EventType The type of the event
+             * @return A reference to the list
+             */
+            template<typename EventType>
+            ListenerList<EventType> &getListenerList()
+            {
+                std::size_t type = internal::getDenseTypeID<BaseListenerList, EventType>();
+                if (type >= _listeners.size())
+                    _listeners.resize(type + 1);
+                if (!_listeners[type])
+                    _listeners[type].reset(new ListenerList<EventType>(type));
+                return *static_cast<ListenerList<EventType> *>(_listeners[type].get());
             }
 
         private:
-            std::queue<internal::ID> _freeIDs; /*!< free ids */
-            uint64_t _maxID; /*!< The last maximum id given */
-            std::unordered_map<std::type_index, std::vector<BaseListener *>> _listeners; /*!< The existing listeners */
+            std::vector<std::unique_ptr<BaseListenerList>> _listeners; /*!< The listeners of each event type indexed by the dense id of the type */
+            std::vector<std::size_t> _queuedTypes; /*!< The dense ids of the event types having queued events */
+            std::vector<std::unique_ptr<BasePostedEvents>> _posted; /*!< The queues of the events posted from other threads */
+            std::mutex _postedMutex; /*!< Mutex protecting _posted */
         };
+
+        template<typename EventType>
+        void PostedEvents<EventType>::emitPosted()
+        {
+            std::size_t count = _count.load(std::memory_order_acquire);
+            std::size_t popped = 0;
+            auto &manager = EventManager::getInstance();
+            try {
+                while (popped < count && _queue.pop([&manager](EventType &event) {
+                    manager.emit<EventType>(event);
+                }))
+                    ++popped;
+            } catch (...) {
+                _count.fetch_sub(popped + 1, std::memory_order_relaxed);
+                throw;
+            }
+            _count.fetch_sub(popped, std::memory_order_relaxed);
+        }
     }
 }
 
@@ -236,10 +829,18 @@ namespace jf {
 
     namespace events {
 
-        class BaseListener;
+        template<typename EventType>
+        class EventSpan;
+
+        class BaseListenerList;
+
+        template<typename EventType>
+        class ListenerList;
+
+        class BasePostedEvents;
 
-        template<typename RegistererType, typename EventType>
-        class EventListener;
+        template<typename EventType>
+        class PostedEvents;
 
         class EventManager;
     }
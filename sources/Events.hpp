@@ -12,6 +12,8 @@
 
 #include "EntityCreatedEvent.hpp"
 #include "EntityDestroyedEvent.hpp"
+#include "EntitiesCreatedEvent.hpp"
+#include "EntitiesDestroyedEvent.hpp"
 #include "ComponentCreatedEvent.hpp"
 #include "ComponentDestroyedEvent.hpp"
 
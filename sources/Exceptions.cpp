@@ -32,6 +32,14 @@ jf::EntityAlreadyRegisteredException::EntityAlreadyRegisteredException(const std
     : ECSException(error, where)
 {}
 
+jf::ComponentNotCopyableException::ComponentNotCopyableException(const std::string &error, const std::string &where)
+    : ECSException(error, where)
+{}
+
+jf::TooManyComponentTypesException::TooManyComponentTypesException(const std::string &error, const std::string &where)
+    : ECSException(error, where)
+{}
+
 jf::SystemAlreadyExistingException::SystemAlreadyExistingException(const std::string &error, const std::string &where)
     : ECSException(error, where)
 {}
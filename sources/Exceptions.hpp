@@ -74,6 +74,34 @@ namespace jf {
         EntityAlreadyRegisteredException(const std::string &error, const std::string &where);
     };
 
+    /*!
+     * @class jf::ComponentNotCopyableException
+     * @brief A class representing a copy of a component that can not be copied
+     */
+    class ComponentNotCopyableException : public ECSException {
+    public:
+        /*!
+         * ctor
+         * @param error The error message
+         * @param where The error location
+         */
+        ComponentNotCopyableException(const std::string &error, const std::string &where);
+    };
+
+    /*!
+     * @class jf::TooManyComponentTypesException
+     * @brief A class representing a component type past the JFECS_MAX_COMPONENT_TYPES limit
+     */
+    class TooManyComponentTypesException : public ECSException {
+    public:
+        /*!
+         * ctor
+         * @param error The error message
+         * @param where The error location
+         */
+        TooManyComponentTypesException(const std::string &error, const std::string &where);
+    };
+
     /*!
      * @class SystemAlreadyExistingException
      * @brief An exception throwed when trying to add an already existing system
@@ -126,6 +154,8 @@ namespace jf {
     class BadHandlerException;
 
     class EntityAlreadyRegisteredException;
+    class ComponentNotCopyableException;
+    class TooManyComponentTypesException;
 
     class SystemAlreadyExistingException;
     class SystemLogicalException;
@@ -9,6 +9,8 @@
 
 #include "ID.hpp"
 
+const uint64_t jf::internal::ID::invalidID;
+
 jf::internal::ID::ID()
     : _id(0)
 {}
@@ -17,11 +19,6 @@ jf::internal::ID::ID(uint64_t id)
     : _id(id)
 {}
 
-
-jf::internal::ID::ID(const jf::internal::ID &other)
-    : _id(other._id)
-{}
-
 bool jf::internal::ID::operator!=(const jf::internal::ID &rhs) const
 {
     return _id != rhs._id;
@@ -61,11 +58,3 @@ bool jf::internal::ID::isValid() const
 {
     return _id != invalidID;
 }
-
-jf::internal::ID &jf::internal::ID::operator=(const jf::internal::ID &rhs)
-{
-    if (this == &rhs)
-        return *this;
-    _id = rhs._id;
-    return *this;
-}
@@ -27,10 +27,12 @@ namespace jf {
         /*!
          * @class ID
          * @brief An entity ID
+         *
+         * An ID is trivially copyable so that it can be stored in handlers at no cost
          */
         class ID final {
         public:
-            const uint64_t invalidID = 0; /*!< Something representing an invalid ID */
+            static const uint64_t invalidID = 0; /*!< Something representing an invalid ID */
         public:
             /*!
              * @brief ctor
@@ -41,19 +43,8 @@ namespace jf {
              * @param id The id to set
              */
             explicit ID(uint64_t id);
-            /*!
-             * @brief cpy ctor
-             * @param other The ID to copy
-             */
-            ID(const ID &other);
 
         public:
-            /*!
-             * @brief Assignment operator
-             * @param rhs The ID to assign as
-             * @return This object
-             */
-            ID &operator=(const ID &rhs);
             /*!
              * @brief inequality operator
              * @param rhs The object to compare to
@@ -10,6 +10,8 @@
 #ifndef JFENTITYCOMPONENTSYSTEM_INTERNAL_HPP
 #define JFENTITYCOMPONENTSYSTEM_INTERNAL_HPP
 
+#include <atomic>
+#include <cstddef>
 #include <typeindex>
 
 /*!
@@ -34,6 +36,33 @@ namespace jf {
         {
             return std::type_index(typeid(T));
         };
+
+        /*!
+         * @brief A function used internally to get the next dense id of a family of types
+         * @tparam Family The family of types, each family counts from 0
+         * @return The next unused id of the family
+         */
+        template<typename Family>
+        std::size_t nextDenseTypeID()
+        {
+            static std::atomic<std::size_t> next(0);
+            return next++;
+        }
+
+        /*!
+         * @brief A function used internally to give a small dense id to each type of a family
+         * @tparam Family The family of types, each family counts from 0
+         * @tparam T The type to get the id for
+         * @return The id of the type, the same for the whole program run
+         *
+         * Unlike getTypeIndex the ids can be used as array indexes
+         */
+        template<typename Family, typename T>
+        std::size_t getDenseTypeID()
+        {
+            static const std::size_t id = nextDenseTypeID<Family>();
+            return id;
+        }
     }
 }
 
@@ -0,0 +1,141 @@
+/*
+** EPITECH PROJECT, 2018
+** JFEntityComponentSystem
+** File description:
+** MPSCQueue.hpp
+*/
+
+/* Created the 16/10/2026 at 23:48 by jfrabel */
+
+#ifndef JFENTITYCOMPONENTSYSTEM_MPSCQUEUE_HPP
+#define JFENTITYCOMPONENTSYSTEM_MPSCQUEUE_HPP
+
+#include <atomic>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/*!
+ * @namespace jf
+ * @brief The jfecs library namespace
+ */
+namespace jf {
+
+    /*!
+     * @namespace jf::internal
+     * @brief Do not use this namespace (used internally)
+     */
+    namespace internal {
+
+        /*!
+         * @class MPSCQueue
+         * @brief An unbounded lock-free queue with many producers and a single consumer
+         * @tparam T The type of the stored values
+         *
+         * push can be called from any number of threads at once, it never blocks nor waits for the consumer.
+         * pop must only be called by one thread at a time.
+         * A value pushed while another push is not finished may only be seen by the consumer once the other push is done.
+         */
+        template<typename T>
+        class MPSCQueue final {
+        public:
+            /*!
+             * @brief ctor
+             */
+            MPSCQueue()
+                : _head(new Node()), _tail(_head.load())
+            {}
+
+            /*!
+             * @brief cpy ctor
+             * @param other The queue to copy
+             */
+            MPSCQueue(const MPSCQueue<T> &other) = delete;
+
+            /*!
+             * @brief dtor, destroy the values left in the queue
+             */
+            ~MPSCQueue()
+            {
+                while (pop([](T &) {}));
+                delete _tail;
+            }
+
+            /*!
+             * @brief Assignment operator
+             * @param other The queue to assign to
+             * @return The current instance
+             */
+            MPSCQueue<T> &operator=(const MPSCQueue<T> &other) = delete;
+
+        public:
+            /*!
+             * @brief Add a value at the end of the queue, can be called from any thread
+             * @param value The value to add
+             */
+            void push(const T &value)
+            {
+                Node *node = new Node();
+                try {
+                    new (&node->data) T(value);
+                } catch (...) {
+                    delete node;
+                    throw;
+                }
+                Node *previous = _head.exchange(node, std::memory_order_acq_rel);
+                previous->next.store(node, std::memory_order_release);
+            }
+
+            /*!
+             * @brief Take the value at the front of the queue, must only be called by the consumer thread
+             * @tparam Func The type of the callable (void(T &))
+             * @param func The function given the value before it is destroyed
+             * @return true if a value was taken false if the queue looked empty
+             */
+            template<typename Func>
+            bool pop(Func func)
+            {
+                Node *next = _tail->next.load(std::memory_order_acquire);
+                if (next == nullptr)
+                    return false;
+                T *value = reinterpret_cast<T *>(&next->data);
+                delete _tail;
+                _tail = next;
+                try {
+                    func(*value);
+                } catch (...) {
+                    value->~T();
+                    throw;
+                }
+                value->~T();
+                return true;
+            }
+
+        private:
+            /*!
+             * @struct Node
+             * @brief A link of the queue, the last popped node is kept as the front of the queue without a value
+             */
+            struct Node {
+                std::atomic<Node *> next{nullptr}; /*!< The next node, nullptr if it is the last one */
+                typename std::aligned_storage<sizeof(T), alignof(T)>::type data; /*!< The memory of the value */
+            };
+
+            std::atomic<Node *> _head; /*!< The last pushed node, shared by the producers */
+            Node *_tail; /*!< The last popped node, only used by the consumer */
+        };
+    }
+}
+
+#else
+
+namespace jf {
+
+    namespace internal {
+
+        template<typename T>
+        class MPSCQueue;
+    }
+}
+
+#endif //JFENTITYCOMPONENTSYSTEM_MPSCQUEUE_HPP
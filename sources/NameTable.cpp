@@ -0,0 +1,75 @@
+/*
+** EPITECH PROJECT, 2018
+** JFEntityComponentSystem
+** File description:
+** NameTable.cpp
+*/
+
+/* Created the 17/10/2026 at 10:41 by jfrabel */
+
+#include "NameTable.hpp"
+
+jf::internal::NameTable &jf::internal::NameTable::getInstance()
+{
+    static NameTable instance;
+    return instance;
+}
+
+jf::internal::NameTable::NameTable()
+    : _names(), _references(), _freeIDs(), _ids()
+{}
+
+uint32_t jf::internal::NameTable::intern(const std::string &name)
+{
+    auto id = _ids.find(name);
+    if (id != _ids.end()) {
+        ++_references[id->second];
+        return id->second;
+    }
+    uint32_t nameID;
+    if (_freeIDs.empty()) {
+        nameID = static_cast<uint32_t>(_names.size());
+        _names.push_back(name);
+        _references.push_back(0);
+    } else {
+        nameID = _freeIDs.back();
+        _freeIDs.pop_back();
+        _names[nameID] = name;
+    }
+    _references[nameID] = 1;
+    _ids.emplace(_names[nameID], nameID);
+    return nameID;
+}
+
+void jf::internal::NameTable::acquire(uint32_t nameID)
+{
+    ++_references[nameID];
+}
+
+void jf::internal::NameTable::release(uint32_t nameID)
+{
+    if (--_references[nameID] != 0)
+        return;
+    _ids.erase(_names[nameID]);
+    std::string().swap(_names[nameID]);
+    _freeIDs.push_back(nameID);
+}
+
+bool jf::internal::NameTable::find(const std::string &name, uint32_t &nameID) const
+{
+    auto id = _ids.find(name);
+    if (id == _ids.end())
+        return false;
+    nameID = id->second;
+    return true;
+}
+
+const std::string &jf::internal::NameTable::getName(uint32_t nameID) const
+{
+    return _names[nameID];
+}
+
+std::size_t jf::internal::NameTable::size() const
+{
+    return _ids.size();
+}
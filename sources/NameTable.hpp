@@ -0,0 +1,127 @@
+/*
+** EPITECH PROJECT, 2018
+** JFEntityComponentSystem
+** File description:
+** NameTable.hpp
+*/
+
+/* Created the 17/10/2026 at 10:41 by jfrabel */
+
+#ifndef JFENTITYCOMPONENTSYSTEM_NAMETABLE_HPP
+#define JFENTITYCOMPONENTSYSTEM_NAMETABLE_HPP
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/*!
+ * @namespace jf
+ * @brief The jfecs library namespace
+ */
+namespace jf {
+
+    /*!
+     * @namespace jf::internal
+     * @brief Do not use this namespace (used internally)
+     */
+    namespace internal {
+
+        /*!
+         * @class NameTable
+         * @brief A singleton class interning the names of the entities
+         *
+         * Each distinct name is stored once and given a 32 bits id, entities only store this id.
+         * Each entity holds a reference on its name, a name is removed when its last reference is released
+         * and its id is reused by the next new name, so unique names do not accumulate across level loads.
+         * Names are interned when entities are created so, like entity creation, the table is not thread safe.
+         */
+        class NameTable final {
+        public:
+            /*!
+             * @brief Get the instance of the singleton
+             * @return The instance of the singleton
+             */
+            static NameTable &getInstance();
+
+        private:
+            /*!
+             * @brief ctor
+             */
+            NameTable();
+            /*!
+             * @brief dtor
+             */
+            ~NameTable() = default;
+
+        public:
+            /*!
+             * @brief cpy ctor
+             * @param other The table to copy
+             */
+            NameTable(const NameTable &other) = delete;
+            /*!
+             * @brief Assignment operator
+             * @param other The table to assign to
+             * @return The current instance
+             */
+            NameTable &operator=(const NameTable &other) = delete;
+
+        public:
+            /*!
+             * @brief Get the id of a name, adding the name to the table if needed, and take a reference on it
+             * @param name The name
+             * @return The id of the name, to give back to release
+             */
+            uint32_t intern(const std::string &name);
+            /*!
+             * @brief Take one more reference on a name
+             * @param nameID The id of the name, must be referenced
+             */
+            void acquire(uint32_t nameID);
+            /*!
+             * @brief Drop a reference on a name, removing the name when it was the last one
+             * @param nameID The id of the name, must be referenced
+             */
+            void release(uint32_t nameID);
+            /*!
+             * @brief Get the id of a name without adding it
+             * @param name The name
+             * @param nameID Set to the id of the name if it is in the table
+             * @return true if the name is in the table false otherwise
+             */
+            bool find(const std::string &name, uint32_t &nameID) const;
+            /*!
+             * @brief Get a name from its id
+             * @param nameID The id of the name, must have been returned by intern
+             * @return A reference on the name, valid as long as the name is referenced
+             */
+            const std::string &getName(uint32_t nameID) const;
+            /*!
+             * @brief Get the number of distinct names
+             * @return The number of referenced names in the table
+             */
+            std::size_t size() const;
+
+        private:
+            std::deque<std::string> _names; /*!< The names indexed by id, a deque never moves its elements */
+            std::vector<std::size_t> _references; /*!< The number of references on each name, 0 for the free ids */
+            std::vector<uint32_t> _freeIDs; /*!< The ids of the removed names */
+            std::unordered_map<std::string_view, uint32_t> _ids; /*!< The id of each name, the keys view the strings of _names */
+        };
+    }
+}
+
+#else
+
+namespace jf {
+
+    namespace internal {
+
+        class NameTable;
+    }
+}
+
+#endif //JFENTITYCOMPONENTSYSTEM_NAMETABLE_HPP
@@ -0,0 +1,30 @@
+/*
+** EPITECH PROJECT, 2018
+** JFEntityComponentSystem
+** File description:
+** Prefab.cpp
+*/
+
+/* Created the 17/10/2026 at 09:12 by jfrabel */
+
+#include "Prefab.hpp"
+#include "Exceptions.hpp"
+
+jf::entities::Prefab::Prefab(const jf::entities::EntityHandler &templateEntity)
+    : _template(templateEntity), _types()
+{
+    if (!_template.isValid())
+        throw BadHandlerException("The template entity does not exist", "Prefab");
+    _types = _template->getComponentTypes();
+}
+
+const jf::entities::EntityHandler &jf::entities::Prefab::getTemplate() const
+{
+    return _template;
+}
+
+const std::vector<std::pair<std::type_index, jf::components::BaseComponentStorage *>> &
+jf::entities::Prefab::getComponentTypes() const
+{
+    return _types;
+}
@@ -0,0 +1,79 @@
+/*
+** EPITECH PROJECT, 2018
+** JFEntityComponentSystem
+** File description:
+** Prefab.hpp
+*/
+
+/* Created the 17/10/2026 at 09:12 by jfrabel */
+
+#ifndef JFENTITYCOMPONENTSYSTEM_PREFAB_HPP
+#define JFENTITYCOMPONENTSYSTEM_PREFAB_HPP
+
+#include <typeindex>
+#include <utility>
+#include <vector>
+#include "EntityHandler.hpp"
+#include "ComponentStorage.hpp"
+
+/*!
+ * @namespace jf
+ * @brief The jfecs library namespace
+ */
+namespace jf {
+
+    /*!
+     * @namespace jf::entities
+     * @brief Namespace for entity related classes
+     */
+    namespace entities {
+
+        /*!
+         * @class Prefab
+         * @brief A class describing entities to create by copying a template entity
+         *
+         * The prefab remembers the types of the components the template had when the prefab was created,
+         * EntityManager::instantiate then copies these components of the template on each new entity.
+         * The template is a regular entity, it is usually disabled and kept so that it is not seen by the systems.
+         * All the components of the template must be copy constructible.
+         */
+        class Prefab final {
+        public:
+            /*!
+             * @brief ctor
+             * @param templateEntity The entity to copy
+             * @throw jf::BadHandlerException if the handler is invalid
+             */
+            explicit Prefab(const EntityHandler &templateEntity);
+
+        public:
+            /*!
+             * @brief Get the template entity
+             * @return A handler on the template entity
+             */
+            const EntityHandler &getTemplate() const;
+
+            /*!
+             * @brief Get the types of the components copied on each new entity
+             * @return The type and the storage of each component
+             */
+            const std::vector<std::pair<std::type_index, components::BaseComponentStorage *>> &getComponentTypes() const;
+
+        private:
+            EntityHandler _template; /*!< The template entity */
+            std::vector<std::pair<std::type_index, components::BaseComponentStorage *>> _types; /*!< The components of the template */
+        };
+    }
+}
+
+#else
+
+namespace jf {
+
+    namespace entities {
+
+        class Prefab;
+    }
+}
+
+#endif //JFENTITYCOMPONENTSYSTEM_PREFAB_HPP
@@ -0,0 +1,79 @@
+/*
+** EPITECH PROJECT, 2018
+** JFEntityComponentSystem
+** File description:
+** Signature.hpp
+*/
+
+/* Created the 17/10/2026 at 13:05 by jfrabel */
+
+#ifndef JFENTITYCOMPONENTSYSTEM_SIGNATURE_HPP
+#define JFENTITYCOMPONENTSYSTEM_SIGNATURE_HPP
+
+#include <bitset>
+#include <cstddef>
+#include <initializer_list>
+#include "Internal.hpp"
+#include "Exceptions.hpp"
+
+#ifndef JFECS_MAX_COMPONENT_TYPES
+#define JFECS_MAX_COMPONENT_TYPES 256
+#endif
+
+/*!
+ * @namespace jf
+ * @brief The jfecs library namespace
+ */
+namespace jf {
+
+    /*!
+     * @namespace jf::components
+     * @brief The namespace containing the components
+     */
+    namespace components {
+
+        class Component;
+
+        /*!
+         * @brief The set of component types of an entity, bit i is set if the entity has the component type of id i
+         *
+         * The number of component types a program can use is JFECS_MAX_COMPONENT_TYPES (256 by default),
+         * define it (the same way for the library and the program) to change it.
+         */
+        using Signature = std::bitset<JFECS_MAX_COMPONENT_TYPES>;
+
+        /*!
+         * @brief Get the dense id of a component type, the index of its bit in the signatures
+         * @tparam C The type of component
+         * @return The id of the component type
+         * @throw jf::TooManyComponentTypesException if the program uses more than JFECS_MAX_COMPONENT_TYPES component types
+         */
+        template<typename C>
+        std::size_t getComponentTypeID()
+        {
+            std::size_t id = internal::getDenseTypeID<Component, C>();
+            if (id >= JFECS_MAX_COMPONENT_TYPES)
+                throw TooManyComponentTypesException("More component types than JFECS_MAX_COMPONENT_TYPES", "getComponentTypeID");
+            return id;
+        }
+
+        /*!
+         * @brief Get the signature of a set of component types
+         * @tparam Components The types of components
+         * @return The signature with the bit of each given type set, built once
+         * @throw jf::TooManyComponentTypesException if the program uses more than JFECS_MAX_COMPONENT_TYPES component types
+         */
+        template<typename... Components>
+        const Signature &getSignature()
+        {
+            static const Signature signature = [] {
+                Signature bits;
+                (void)std::initializer_list<int>{(bits.set(getComponentTypeID<Components>()), 0)...};
+                return bits;
+            }();
+            return signature;
+        }
+    }
+}
+
+#endif //JFENTITYCOMPONENTSYSTEM_SIGNATURE_HPP
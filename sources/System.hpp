@@ -11,6 +11,7 @@
 #define JFENTITYCOMPONENTSYSTEM_SYSTEM_HPP
 
 #include <chrono>
+#include "SystemAccess.hpp"
 
 /*!
  * @namespace jf
@@ -35,6 +36,8 @@ namespace jf {
          * Systems that have been stoped can be resumed, then onStart will be called again and onUpdate each iteration.
          * On engine stop onTearDown will be called on the system.
          *
+         * onUpdate of systems that declared their access (see declareAccess) may run on several threads at once.
+         *
          * Please remember that a stopped system can still receive events.
          * If you do not wish this behaviour it's up to you to implement a "state" for your systems
          * or to unregister the listeners.
@@ -66,6 +69,19 @@ namespace jf {
              * @brief A method called on system tear down
              */
             virtual void onTearDown() = 0;
+            /*!
+             * @brief A method called once when the system is added to declare the components used by onUpdate
+             * @param access The access to fill
+             *
+             * Systems with a declared access are updated at the same time as the other systems they do not conflict with,
+             * so their onUpdate must not create or delete entities, enable or disable entities, assign or remove components or emit events
+             * (EntityManager::safeDeleteEntity can be used).
+             * By default nothing is declared and the system is updated alone.
+             */
+            virtual void declareAccess(SystemAccess &access) const
+            {
+                (void)access;
+            }
         };
     }
 }
@@ -0,0 +1,58 @@
+/*
+** EPITECH PROJECT, 2018
+** JFEntityComponentSystem
+** File description:
+** SystemAccess.cpp
+*/
+
+/* Created the 16/10/2026 at 19:05 by jfrabel */
+
+#include <algorithm>
+#include "SystemAccess.hpp"
+
+jf::systems::SystemAccess::SystemAccess()
+    : _reads(), _writes(), _declared(false)
+{
+
+}
+
+jf::systems::SystemAccess &jf::systems::SystemAccess::none()
+{
+    _declared = true;
+    return *this;
+}
+
+bool jf::systems::SystemAccess::isDeclared() const
+{
+    return _declared;
+}
+
+bool jf::systems::SystemAccess::conflictsWith(const jf::systems::SystemAccess &other) const
+{
+    if (!_declared || !other._declared)
+        return true;
+    for (auto &type : _writes) {
+        if (contains(other._reads, type) || contains(other._writes, type))
+            return true;
+    }
+    for (auto &type : other._writes) {
+        if (contains(_reads, type))
+            return true;
+    }
+    return false;
+}
+
+const std::vector<std::type_index> &jf::systems::SystemAccess::getReads() const
+{
+    return _reads;
+}
+
+const std::vector<std::type_index> &jf::systems::SystemAccess::getWrites() const
+{
+    return _writes;
+}
+
+bool jf::systems::SystemAccess::contains(const std::vector<std::type_index> &types, const std::type_index &type)
+{
+    return std::find(types.begin(), types.end(), type) != types.end();
+}
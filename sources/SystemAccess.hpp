@@ -0,0 +1,128 @@
+/*
+** EPITECH PROJECT, 2018
+** JFEntityComponentSystem
+** File description:
+** SystemAccess.hpp
+*/
+
+/* Created the 16/10/2026 at 19:05 by jfrabel */
+
+#ifndef JFENTITYCOMPONENTSYSTEM_SYSTEMACCESS_HPP
+#define JFENTITYCOMPONENTSYSTEM_SYSTEMACCESS_HPP
+
+#include <typeindex>
+#include <vector>
+#include "Internal.hpp"
+
+/*!
+ * @namespace jf
+ * @brief The jfecs library namespace
+ */
+namespace jf {
+
+    /*!
+     * @namespace jf::systems
+     * @brief A namespace used for all system related classes
+     */
+    namespace systems {
+
+        /*!
+         * @class SystemAccess
+         * @brief The component types a system reads and writes in its onUpdate
+         *
+         * Filled by ISystem::declareAccess. Two systems conflict if one of them writes a type the other reads or writes.
+         * Systems that do not conflict can be updated at the same time by the SystemManager.
+         * A system that declares nothing conflicts with every system.
+         */
+        class SystemAccess {
+        public:
+            /*!
+             * @brief ctor, nothing declared
+             */
+            SystemAccess();
+
+            /*!
+             * @brief Declare component types read by the system
+             * @tparam C The read component types
+             * @return The current instance
+             */
+            template<typename ...C>
+            SystemAccess &reads()
+            {
+                _declared = true;
+                _reads.insert(_reads.end(), {internal::getTypeIndex<C>()...});
+                return *this;
+            }
+
+            /*!
+             * @brief Declare component types written by the system
+             * @tparam C The written component types
+             * @return The current instance
+             */
+            template<typename ...C>
+            SystemAccess &writes()
+            {
+                _declared = true;
+                _writes.insert(_writes.end(), {internal::getTypeIndex<C>()...});
+                return *this;
+            }
+
+            /*!
+             * @brief Declare that the system does not touch any component (can run with any other declared system)
+             * @return The current instance
+             */
+            SystemAccess &none();
+
+            /*!
+             * @brief Get if the system declared its access
+             * @return true if reads, writes or none was called
+             */
+            bool isDeclared() const;
+
+            /*!
+             * @brief Check if two systems can not be updated at the same time
+             * @param other The access of the other system
+             * @return true if one of the systems did not declare its access or if one writes a type used by the other
+             */
+            bool conflictsWith(const SystemAccess &other) const;
+
+            /*!
+             * @brief Get the read component types
+             * @return The types declared with reads
+             */
+            const std::vector<std::type_index> &getReads() const;
+
+            /*!
+             * @brief Get the written component types
+             * @return The types declared with writes
+             */
+            const std::vector<std::type_index> &getWrites() const;
+
+        private:
+            /*!
+             * @brief Check if a type is in a list of types
+             * @param types The list of types
+             * @param type The type to look for
+             * @return true if the type is in the list
+             */
+            static bool contains(const std::vector<std::type_index> &types, const std::type_index &type);
+
+        private:
+            std::vector<std::type_index> _reads; /*!< The read component types */
+            std::vector<std::type_index> _writes; /*!< The written component types */
+            bool _declared; /*!< true if the system declared its access */
+        };
+    }
+}
+
+#else
+
+namespace jf {
+
+    namespace systems {
+
+        class SystemAccess;
+    }
+}
+
+#endif //JFENTITYCOMPONENTSYSTEM_SYSTEMACCESS_HPP
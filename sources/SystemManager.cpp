@@ -7,9 +7,13 @@
 
 /* Created the 20/04/2019 at 21:54 by jfrabel */
 
+#include <algorithm>
+#include <functional>
 #include <vector>
 #include <iostream>
 #include "SystemManager.hpp"
+#include "EventManager.hpp"
+#include "ThreadPool.hpp"
 
 jf::systems::SystemManager &jf::systems::SystemManager::getInstance()
 {
@@ -18,103 +22,350 @@ jf::systems::SystemManager &jf::systems::SystemManager::getInstance()
 }
 
 jf::systems::SystemManager::SystemManager()
-    : _systems(), _timeScale(1), _last(std::chrono::steady_clock::now())
+    : _systems(), _added(), _running(), _toUpdate(), _beforeFixedWaves(), _fixedWaves(), _afterFixedWaves(), _wavesDirty(true),
+    _updateErrors(), _insertions(0), _ticking(false), _timeScale(1), _last(std::chrono::steady_clock::now()),
+    _fixedTimeStep(0), _maxSubSteps(5), _batchSubSteps(false), _accumulator(0), _subSteps(0)
 {
 
 }
 
 jf::systems::SystemManager::~SystemManager()
 {
+    _ticking = true;
     for (auto &system : _systems) {
-        switch (system.second.first) {
+        if (system.system == nullptr)
+            continue;
+        switch (system.state) {
         case NOT_STARTED:
-            delete system.second.second;
+            delete system.system;
             break;
         case AWAKING:
-            system.second.second->onAwake();
+            system.system->onAwake();
 #ifdef __unix__
             __attribute__((fallthrough));
 #endif
         case STARTING:
-            system.second.second->onStart();
+            system.system->onStart();
 #ifdef __unix__
             __attribute__((fallthrough));
 #endif
         case RUNNING:
         case STOPPING:
-            system.second.second->onStop();
+            system.system->onStop();
 #ifdef __unix__
             __attribute__((fallthrough));
 #endif
         case STOPPED:
         case TEARING_DOWN:
-            system.second.second->onTearDown();
-            delete system.second.second;
+            system.system->onTearDown();
+            delete system.system;
             break;
         }
     }
+    for (auto &system : _added)
+        delete system.system;
 }
 
 void jf::systems::SystemManager::tick()
 {
+    events::EventManager::getInstance().dispatchQueued();
     auto now = std::chrono::steady_clock::now();
     std::chrono::nanoseconds elapsedTime = std::chrono::duration_cast<std::chrono::nanoseconds>((now - _last) * _timeScale);
-    std::vector<std::type_index> toErase;
-    for (auto &system : _systems) {
-        switch (system.second.first) {
-        case NOT_STARTED:
-            break;
-        case AWAKING:
-            try {
-                system.second.second->onAwake();
-            } catch (std::exception &e) {
-                addError(*system.second.second, e.what(), ErrorReport::ERROR_TYPE_ON_AWAKE);
-                system.second.first = NOT_STARTED;
+    _toUpdate.clear();
+    _ticking = true;
+    try {
+        for (auto &system : _systems) {
+            if (system.system == nullptr)
                 continue;
+            switch (system.state) {
+            case NOT_STARTED:
+                break;
+            case AWAKING:
+                try {
+                    JFECS_PROFILE_SCOPE(system.timings[CALLBACK_ON_AWAKE], _tracer, system.type, CALLBACK_ON_AWAKE);
+                    system.system->onAwake();
+                } catch (std::exception &e) {
+                    addError(*system.system, e.what(), ErrorReport::ERROR_TYPE_ON_AWAKE);
+                    system.state = NOT_STARTED;
+                    continue;
+                }
+                system.state = STARTING;
+                break;
+            case STARTING:
+                try {
+                    JFECS_PROFILE_SCOPE(system.timings[CALLBACK_ON_START], _tracer, system.type, CALLBACK_ON_START);
+                    system.system->onStart();
+                } catch (std::exception &e) {
+                    addError(*system.system, e.what(), ErrorReport::ERROR_TYPE_ON_START);
+                    system.state = STOPPED;
+                    continue;
+                }
+                system.state = RUNNING;
+                break;
+            case RUNNING:
+                _toUpdate.push_back(&system);
+                break;
+            case STOPPING:
+                try {
+                    JFECS_PROFILE_SCOPE(system.timings[CALLBACK_ON_STOP], _tracer, system.type, CALLBACK_ON_STOP);
+                    system.system->onStop();
+                } catch (std::exception &e) {
+                    addError(*system.system, e.what(), ErrorReport::ERROR_TYPE_ON_STOP);
+                }
+                system.state = STOPPED;
+                break;
+            case STOPPED:
+                break;
+            case TEARING_DOWN:
+                try {
+                    JFECS_PROFILE_SCOPE(system.timings[CALLBACK_ON_TEARDOWN], _tracer, system.type, CALLBACK_ON_TEARDOWN);
+                    system.system->onTearDown();
+                } catch (std::exception &e) {
+                    addError(*system.system, e.what(), ErrorReport::ERROR_TYPE_ON_TEARDOWN);
+                }
+                delete system.system;
+                system.system = nullptr;
+                break;
             }
-            system.second.first = STARTING;
-            break;
-        case STARTING:
-            try {
-                system.second.second->onStart();
-            } catch (std::exception &e) {
-                addError(*system.second.second, e.what(), ErrorReport::ERROR_TYPE_ON_START);
-                system.second.first = STOPPED;
-                continue;
-            }
-            system.second.first = RUNNING;
-            break;
-        case RUNNING:
+        }
+        if (_wavesDirty || _toUpdate != _running)
+            buildWaves();
+        updatePhases(elapsedTime);
+    } catch (...) {
+        endTick();
+        throw;
+    }
+    endTick();
+    _last = now;
+}
+
+void jf::systems::SystemManager::endTick()
+{
+    _ticking = false;
+    auto removed = std::remove_if(_systems.begin(), _systems.end(), [](const SystemInfo &system) {
+        return system.system == nullptr;
+    });
+    if (removed != _systems.end()) {
+        _systems.erase(removed, _systems.end());
+        _wavesDirty = true;
+    }
+    if (_added.empty())
+        return;
+    _wavesDirty = true;
+    _systems.insert(_systems.end(), _added.begin(), _added.end());
+    _added.clear();
+    sortSystems(_systems);
+}
+
+void jf::systems::SystemManager::buildWaves()
+{
+    _running.swap(_toUpdate);
+    auto fixedBegin = std::find_if(_running.begin(), _running.end(), [](const SystemInfo *system) {
+        return system->order.getPhase() >= FIXED_UPDATE;
+    });
+    auto fixedEnd = std::find_if(fixedBegin, _running.end(), [](const SystemInfo *system) {
+        return system->order.getPhase() > FIXED_UPDATE;
+    });
+    buildWaves(std::vector<SystemInfo *>(_running.begin(), fixedBegin), _beforeFixedWaves);
+    buildWaves(std::vector<SystemInfo *>(fixedBegin, fixedEnd), _fixedWaves);
+    buildWaves(std::vector<SystemInfo *>(fixedEnd, _running.end()), _afterFixedWaves);
+    _wavesDirty = false;
+}
+
+void jf::systems::SystemManager::buildWaves(const std::vector<SystemInfo *> &systems, Waves &waves)
+{
+    std::vector<std::size_t> indexes(systems.size(), 0);
+    std::size_t waveCount = 0;
+    for (std::size_t i = 0; i < systems.size(); ++i) {
+        for (std::size_t j = 0; j < i; ++j) {
+            if (indexes[j] >= indexes[i] && (isOrdered(*systems[i], *systems[j]) || systems[i]->access.conflictsWith(systems[j]->access)))
+                indexes[i] = indexes[j] + 1;
+        }
+        waveCount = std::max(waveCount, indexes[i] + 1);
+    }
+    waves.assign(waveCount, std::vector<SystemInfo *>());
+    for (std::size_t i = 0; i < systems.size(); ++i)
+        waves[indexes[i]].push_back(systems[i]);
+}
+
+void jf::systems::SystemManager::updatePhases(const std::chrono::nanoseconds &elapsedTime)
+{
+    _subSteps = 0;
+    if (_fixedTimeStep.count() <= 0) {
+        updateSystems(_beforeFixedWaves, elapsedTime);
+        updateSystems(_fixedWaves, elapsedTime);
+        updateSystems(_afterFixedWaves, elapsedTime);
+        return;
+    }
+    updateSystems(_beforeFixedWaves, elapsedTime);
+    _accumulator += elapsedTime;
+    while (_accumulator >= _fixedTimeStep && _subSteps < _maxSubSteps) {
+        _accumulator -= _fixedTimeStep;
+        ++_subSteps;
+    }
+    if (_accumulator >= _fixedTimeStep)
+        _accumulator %= _fixedTimeStep;
+    if (_batchSubSteps && _subSteps > 0) {
+        updateSystems(_fixedWaves, _fixedTimeStep * _subSteps);
+    } else {
+        for (unsigned int i = 0; i < _subSteps; ++i)
+            updateSystems(_fixedWaves, _fixedTimeStep);
+    }
+    updateSystems(_afterFixedWaves, elapsedTime);
+}
+
+void jf::systems::SystemManager::updateSystems(const Waves &waves, const std::chrono::nanoseconds &elapsedTime)
+{
+    auto &errors = _updateErrors;
+    for (auto &wave : waves) {
+        errors.assign(wave.size(), std::make_pair(false, std::string()));
+        auto update = [this, &wave, &errors, &elapsedTime](std::size_t i) {
             try {
-                system.second.second->onUpdate(elapsedTime);
+                JFECS_PROFILE_SCOPE(wave[i]->timings[CALLBACK_ON_UPDATE], _tracer, wave[i]->type, CALLBACK_ON_UPDATE);
+                wave[i]->system->onUpdate(elapsedTime);
             } catch (std::exception &e) {
-                addError(*system.second.second, e.what(), ErrorReport::ERROR_TYPE_ON_UPDATE);
+                errors[i] = std::make_pair(true, std::string(e.what()));
             }
-            break;
-        case STOPPING:
-            try {
-                system.second.second->onStop();
-            } catch (std::exception &e) {
-                addError(*system.second.second, e.what(), ErrorReport::ERROR_TYPE_ON_STOP);
+        };
+        /* Given by reference so that the std::function does not allocate */
+        ThreadPool::getInstance().run(wave.size(), std::ref(update));
+        for (std::size_t i = 0; i < wave.size(); ++i) {
+            if (errors[i].first)
+                addError(*wave[i]->system, errors[i].second, ErrorReport::ERROR_TYPE_ON_UPDATE);
+        }
+    }
+}
+
+void jf::systems::SystemManager::insertSystem(const std::type_index &type, jf::systems::ISystem *system,
+                                              const jf::systems::SystemOrder &order)
+{
+    SystemInfo info(type, system, order, _insertions);
+    std::vector<SystemInfo> systems(_systems);
+    try {
+        system->declareAccess(info.access);
+        systems.insert(systems.end(), _added.begin(), _added.end());
+        systems.push_back(info);
+        sortSystems(systems);
+    } catch (...) {
+        delete system;
+        throw;
+    }
+    ++_insertions;
+    if (_ticking) {
+        _added.push_back(info);
+    } else {
+        _systems.swap(systems);
+        _wavesDirty = true;
+    }
+}
+
+jf::systems::SystemManager::SystemInfo &jf::systems::SystemManager::findSystem(const std::type_index &type,
+                                                                               const std::string &where)
+{
+    return const_cast<SystemInfo &>(static_cast<const SystemManager *>(this)->findSystem(type, where));
+}
+
+const jf::systems::SystemManager::SystemInfo &jf::systems::SystemManager::findSystem(const std::type_index &type,
+                                                                                     const std::string &where) const
+{
+    const SystemInfo *system = findSystem(type);
+    if (system == nullptr) {
+        throw SystemNotFoundException("System not found", where);
+    }
+    return *system;
+}
+
+const jf::systems::SystemManager::SystemInfo *jf::systems::SystemManager::findSystem(const std::type_index &type) const
+{
+    for (auto &system : _systems) {
+        if (system.type == type && system.system != nullptr)
+            return &system;
+    }
+    for (auto &system : _added) {
+        if (system.type == type && system.system != nullptr)
+            return &system;
+    }
+    return nullptr;
+}
+
+void jf::systems::SystemManager::eraseSystem(jf::systems::SystemManager::SystemInfo &system)
+{
+    delete system.system;
+    system.system = nullptr;
+    if (_ticking)
+        return;
+    _systems.erase(std::remove_if(_systems.begin(), _systems.end(), [](const SystemInfo &info) {
+        return info.system == nullptr;
+    }), _systems.end());
+    _wavesDirty = true;
+}
+
+void jf::systems::SystemManager::sortSystems(std::vector<jf::systems::SystemManager::SystemInfo> &systems)
+{
+    std::size_t count = systems.size();
+    std::vector<std::vector<std::size_t>> next(count);
+    std::vector<std::size_t> previousCount(count, 0);
+    auto link = [&systems, &next, &previousCount](std::size_t from, std::size_t to) {
+        if (systems[from].order.getPhase() > systems[to].order.getPhase()) {
+            throw SystemLogicalException("A system can not be updated before a system of a previous phase", "addSystem");
+        }
+        next[from].push_back(to);
+        ++previousCount[to];
+    };
+    for (std::size_t i = 0; i < count; ++i) {
+        for (std::size_t j = 0; j < count; ++j) {
+            for (auto &type : systems[i].order.getBefore()) {
+                if (systems[j].type == type)
+                    link(i, j);
             }
-            system.second.first = STOPPED;
-            break;
-        case STOPPED:
-            break;
-        case TEARING_DOWN:
-            try {
-                system.second.second->onTearDown();
-            } catch (std::exception &e) {
-                addError(*system.second.second, e.what(), ErrorReport::ERROR_TYPE_ON_TEARDOWN);
+            for (auto &type : systems[i].order.getAfter()) {
+                if (systems[j].type == type)
+                    link(j, i);
             }
-            delete system.second.second;
-            toErase.push_back(system.first);
-            break;
         }
     }
-    for (auto &typeindex : toErase)
-        _systems.erase(typeindex);
-    _last = now;
+    std::vector<SystemInfo> sorted;
+    std::vector<bool> done(count, false);
+    sorted.reserve(count);
+    while (sorted.size() < count) {
+        std::size_t best = count;
+        for (std::size_t i = 0; i < count; ++i) {
+            if (done[i] || previousCount[i] != 0)
+                continue;
+            if (best == count || comesFirst(systems[i], systems[best]))
+                best = i;
+        }
+        if (best == count) {
+            throw SystemLogicalException("The ordering constraints of the systems form a cycle", "addSystem");
+        }
+        done[best] = true;
+        for (auto &following : next[best])
+            --previousCount[following];
+        sorted.push_back(systems[best]);
+    }
+    systems.swap(sorted);
+}
+
+bool jf::systems::SystemManager::comesFirst(const jf::systems::SystemManager::SystemInfo &lhs,
+                                            const jf::systems::SystemManager::SystemInfo &rhs)
+{
+    if (lhs.order.getPhase() != rhs.order.getPhase())
+        return lhs.order.getPhase() < rhs.order.getPhase();
+    if (lhs.order.getPriority() != rhs.order.getPriority())
+        return lhs.order.getPriority() > rhs.order.getPriority();
+    return lhs.insertion < rhs.insertion;
+}
+
+bool jf::systems::SystemManager::isOrdered(const jf::systems::SystemManager::SystemInfo &lhs,
+                                           const jf::systems::SystemManager::SystemInfo &rhs)
+{
+    if (lhs.order.getPhase() != rhs.order.getPhase())
+        return true;
+    auto contains = [](const std::vector<std::type_index> &types, const std::type_index &type) {
+        return std::find(types.begin(), types.end(), type) != types.end();
+    };
+    return contains(lhs.order.getBefore(), rhs.type) || contains(lhs.order.getAfter(), rhs.type)
+        || contains(rhs.order.getBefore(), lhs.type) || contains(rhs.order.getAfter(), lhs.type);
 }
 
 float jf::systems::SystemManager::getTimeScale() const
@@ -127,6 +378,32 @@ void jf::systems::SystemManager::setTimeScale(float scale)
     _timeScale = scale;
 }
 
+void jf::systems::SystemManager::setFixedTimeStep(const std::chrono::nanoseconds &step, unsigned int maxSubSteps,
+                                                  bool batchSubSteps)
+{
+    _fixedTimeStep = step.count() > 0 ? step : std::chrono::nanoseconds(0);
+    _maxSubSteps = std::max(maxSubSteps, 1u);
+    _batchSubSteps = batchSubSteps;
+    _accumulator = std::chrono::nanoseconds(0);
+}
+
+std::chrono::nanoseconds jf::systems::SystemManager::getFixedTimeStep() const
+{
+    return _fixedTimeStep;
+}
+
+unsigned int jf::systems::SystemManager::getSubStepCount() const
+{
+    return _subSteps;
+}
+
+float jf::systems::SystemManager::getInterpolationAlpha() const
+{
+    if (_fixedTimeStep.count() <= 0)
+        return 1;
+    return static_cast<float>(static_cast<double>(_accumulator.count()) / static_cast<double>(_fixedTimeStep.count()));
+}
+
 std::vector<jf::systems::SystemManager::ErrorReport> jf::systems::SystemManager::getErrors()
 {
     std::vector<ErrorReport> toReturn = _errors;
@@ -134,6 +411,35 @@ std::vector<jf::systems::SystemManager::ErrorReport> jf::systems::SystemManager:
     return toReturn;
 }
 
+#ifdef JFECS_PROFILING
+std::vector<jf::systems::SystemManager::ProfileReport> jf::systems::SystemManager::getProfile() const
+{
+    std::vector<ProfileReport> reports;
+    for (auto &system : _systems) {
+        if (system.system == nullptr)
+            continue;
+        for (int callback = 0; callback < CALLBACK_COUNT; ++callback) {
+            TimingStats stats = system.timings[callback].getStats();
+            if (stats.samples == 0)
+                continue;
+            ProfileReport report = {*system.system, static_cast<SystemCallback>(callback), stats};
+            reports.push_back(report);
+        }
+    }
+    return reports;
+}
+
+void jf::systems::SystemManager::startTrace()
+{
+    _tracer.start();
+}
+
+bool jf::systems::SystemManager::stopTrace(const std::string &path)
+{
+    return _tracer.stop(path);
+}
+#endif
+
 void jf::systems::SystemManager::addError(jf::systems::ISystem &sys, const std::string &msg,
                                           jf::systems::SystemManager::ErrorReport::ErrorType type)
 {
@@ -10,8 +10,10 @@
 #ifndef JFENTITYCOMPONENTSYSTEM_SYSTEMMANAGER_HPP
 #define JFENTITYCOMPONENTSYSTEM_SYSTEMMANAGER_HPP
 
-#include <unordered_map>
+#include <vector>
 #include "System.hpp"
+#include "SystemOrder.hpp"
+#include "SystemProfile.hpp"
 #include "Internal.hpp"
 #include "Exceptions.hpp"
 
@@ -60,6 +62,18 @@ namespace jf {
                 ErrorType type;
             };
 
+#ifdef JFECS_PROFILING
+            /*!
+             * @struct ProfileReport
+             * @brief The timings of a callback of a system
+             */
+            struct ProfileReport {
+                ISystem &system; /*!< The system */
+                SystemCallback callback; /*!< The timed callback */
+                TimingStats stats; /*!< The statistics of the last calls of the callback */
+            };
+#endif
+
         public:
             /*!
              * @brief cpy ctor
@@ -95,6 +109,35 @@ namespace jf {
              */
             void setTimeScale(float scale);
 
+            /*!
+             * @brief Update the systems of the FIXED_UPDATE phase with a fixed time step
+             * @param step The duration of a step (0 to disable the fixed time step, the default)
+             * @param maxSubSteps The maximum number of steps run by a tick, the time left behind is dropped
+             * @param batchSubSteps If true the systems are updated once with the duration of all the steps of the tick
+             *
+             * Each tick adds the elapsed time (scaled by the time scale) to an accumulator
+             * and the FIXED_UPDATE systems are updated once for each full step in the accumulator.
+             * The others phases are updated once per tick with the elapsed time.
+             */
+            void setFixedTimeStep(const std::chrono::nanoseconds &step, unsigned int maxSubSteps = 5, bool batchSubSteps = false);
+            /*!
+             * @brief Get the fixed time step
+             * @return The duration of a step (0 if the fixed time step is disabled)
+             */
+            std::chrono::nanoseconds getFixedTimeStep() const;
+            /*!
+             * @brief Get the number of fixed steps run by the last tick
+             * @return The number of steps
+             */
+            unsigned int getSubStepCount() const;
+            /*!
+             * @brief Get how far the time is between the last fixed step and the next one
+             * @return The time left in the accumulator divided by the step (between 0 and 1), 1 if the fixed time step is disabled
+             *
+             * Used by variable rate systems to interpolate between the previous and the current fixed states
+             */
+            float getInterpolationAlpha() const;
+
             /*!
              * @brief Get the current state of a system
              * @tparam T The type of the system to get
@@ -118,6 +161,8 @@ namespace jf {
             /*!
              * @brief Make all the systems tick. You need to call this function one time per game loop
              * In the best of all words the game loop will only have a call to this function while the game is running
+             *
+             * The queued events (see EventManager::setQueued) are dispatched before the systems are ticked
              */
             void tick();
 
@@ -127,6 +172,28 @@ namespace jf {
              */
             std::vector<ErrorReport> getErrors();
 
+#ifdef JFECS_PROFILING
+            /*!
+             * @brief Get the timings of the callbacks of all the systems (only available with JFECS_PROFILING)
+             * @return A report for each callback of each system called at least once, in update order
+             *
+             * The statistics are computed on the last TimingHistory::windowSize calls of each callback
+             */
+            std::vector<ProfileReport> getProfile() const;
+
+            /*!
+             * @brief Start recording every callback call (only available with JFECS_PROFILING)
+             */
+            void startTrace();
+
+            /*!
+             * @brief Stop recording and write the calls as Chrome trace events (only available with JFECS_PROFILING)
+             * @param path The path of the JSON file to write (open it in chrome://tracing)
+             * @return true if the file was written
+             */
+            bool stopTrace(const std::string &path);
+#endif
+
             /*!
              * @brief Add a system to the existing systems
              * @tparam T The type of the system to add
@@ -137,6 +204,18 @@ namespace jf {
             template<typename T, typename ...Params>
             void addSystem(Params ...params);
 
+            /*!
+             * @brief Add a system to the existing systems at a given place in the tick
+             * @tparam T The type of the system to add
+             * @tparam Params The types of the parameters given to the system constructor
+             * @param order The phase, priority and constraints of the system (see SystemOrder)
+             * @param params The parameters to be given to the system constructor
+             * @throw SystemAlreadyExistingException If a system of type T is still existing and has not be destroyed
+             * @throw SystemLogicalException If the constraints of the systems can not be satisfied (the system is not added)
+             */
+            template<typename T, typename ...Params>
+            void addSystem(const SystemOrder &order, Params ...params);
+
             /*!
              * @brief Set a system state to TEARING_DOWN, the system will be destroyed on next tick
              * @tparam T The type of the system to remove
@@ -182,61 +261,211 @@ namespace jf {
              */
             void addError(ISystem &sys, const std::string &msg, ErrorReport::ErrorType type);
 
+            /*!
+             * @struct SystemInfo
+             * @brief A system and what the manager knows about it
+             */
+            struct SystemInfo {
+                /*!
+                 * @brief ctor
+                 * @param type The type of the system
+                 * @param system The system
+                 * @param order Where the system is updated in a tick
+                 * @param insertion The number of systems added before this one
+                 */
+                SystemInfo(const std::type_index &type, ISystem *system, const SystemOrder &order, std::size_t insertion)
+                    : type(type), state(NOT_STARTED), system(system), access(), order(order), insertion(insertion)
+                {}
+
+                std::type_index type; /*!< The type of the system */
+                SystemState state; /*!< The current state of the system */
+                ISystem *system; /*!< The system (nullptr once removed) */
+                SystemAccess access; /*!< The components used by the system (see ISystem::declareAccess) */
+                SystemOrder order; /*!< Where the system is updated in a tick */
+                std::size_t insertion; /*!< The number of systems added before this one */
+#ifdef JFECS_PROFILING
+                TimingHistory timings[CALLBACK_COUNT]; /*!< The durations of the last calls of each callback */
+#endif
+            };
+
+            /*!
+             * @brief Systems split in waves, the waves are updated one after the other and the systems of a wave at the same time
+             */
+            using Waves = std::vector<std::vector<SystemInfo *>>;
+
+            /*!
+             * @brief Add a newly created system
+             * @param type The type of the system
+             * @param system The system
+             * @param order Where the system is updated in a tick
+             * @throw SystemLogicalException If the constraints of the systems can not be satisfied (the system is deleted)
+             *
+             * During a tick the system is kept apart and added to the others at the end of the tick.
+             */
+            void insertSystem(const std::type_index &type, ISystem *system, const SystemOrder &order);
+
+            /*!
+             * @brief Get a system by type
+             * @param type The type of the system
+             * @param where The calling function (used in the exception)
+             * @return The system
+             * @throw SystemNotFoundException if the system does not exist
+             */
+            SystemInfo &findSystem(const std::type_index &type, const std::string &where);
+
+            /*!
+             * @brief Get a system by type
+             * @param type The type of the system
+             * @param where The calling function (used in the exception)
+             * @return The system
+             * @throw SystemNotFoundException if the system does not exist
+             */
+            const SystemInfo &findSystem(const std::type_index &type, const std::string &where) const;
+
+            /*!
+             * @brief Get a system by type
+             * @param type The type of the system
+             * @return The system or nullptr if the system does not exist
+             */
+            const SystemInfo *findSystem(const std::type_index &type) const;
+
+            /*!
+             * @brief Delete a NOT_STARTED system and remove it from the systems (at the end of the tick if ticking)
+             * @param system The system to remove
+             */
+            void eraseSystem(SystemInfo &system);
+
+            /*!
+             * @brief Sort systems by phase, constraints, priority and insertion
+             * @param systems The systems to sort
+             * @throw SystemLogicalException If the constraints can not be satisfied
+             */
+            static void sortSystems(std::vector<SystemInfo> &systems);
+
+            /*!
+             * @brief Check if a system must be updated before or after another one
+             * @param lhs The first system
+             * @param rhs The second system
+             * @return true if lhs must be updated before or after rhs because of their phases or constraints
+             */
+            static bool isOrdered(const SystemInfo &lhs, const SystemInfo &rhs);
+
+            /*!
+             * @brief Compare two systems without constraints between them
+             * @param lhs The first system
+             * @param rhs The second system
+             * @return true if lhs comes first by phase, then priority, then insertion
+             */
+            static bool comesFirst(const SystemInfo &lhs, const SystemInfo &rhs);
+
+            /*!
+             * @brief Remove the deleted systems and add the systems added during the tick
+             */
+            void endTick();
+
+            /*!
+             * @brief Split the systems to update in this tick (_toUpdate) in the waves before, of and after the FIXED_UPDATE phase
+             *
+             * Only called when the running systems changed, the waves are kept for the next ticks.
+             */
+            void buildWaves();
+
+            /*!
+             * @brief Split systems in waves, non conflicting systems are updated at the same time
+             * @param systems The systems to split, in update order
+             * @param waves The waves to fill
+             *
+             * Each system is put in the first wave after the waves of the previous systems it conflicts with
+             * or must be updated after (see isOrdered).
+             */
+            static void buildWaves(const std::vector<SystemInfo *> &systems, Waves &waves);
+
+            /*!
+             * @brief Call onUpdate on the systems of waves
+             * @param waves The waves to update
+             * @param elapsedTime The elapsed time given to onUpdate
+             *
+             * The waves are run one after the other and the systems of a wave are run on the ThreadPool.
+             */
+            void updateSystems(const Waves &waves, const std::chrono::nanoseconds &elapsedTime);
+
+            /*!
+             * @brief Update the running systems phase by phase, the FIXED_UPDATE phase with the fixed time step if enabled
+             * @param elapsedTime The elapsed time since the last tick
+             */
+            void updatePhases(const std::chrono::nanoseconds &elapsedTime);
+
         private:
-            std::unordered_map<std::type_index, std::pair<SystemState, ISystem *>> _systems; /*!< The systems */
+            std::vector<SystemInfo> _systems; /*!< The systems sorted in update order */
+            std::vector<SystemInfo> _added; /*!< The systems added during the current tick */
+            std::vector<SystemInfo *> _running; /*!< The systems the waves were built for */
+            std::vector<SystemInfo *> _toUpdate; /*!< The systems to update in the current tick */
+            Waves _beforeFixedWaves; /*!< The waves of the phases before FIXED_UPDATE */
+            Waves _fixedWaves; /*!< The waves of the FIXED_UPDATE phase */
+            Waves _afterFixedWaves; /*!< The waves of the phases after FIXED_UPDATE */
+            bool _wavesDirty; /*!< true when _systems changed since the waves were built (their pointers may be stale) */
+            std::vector<std::pair<bool, std::string>> _updateErrors; /*!< The errors of the systems of the current wave */
+            std::size_t _insertions; /*!< The number of systems added so far */
+            bool _ticking; /*!< true while tick is running */
             float _timeScale; /*!< A scaler for the time used (1 by default) */
             std::chrono::steady_clock::time_point _last; /*!< The internal clock used to compute time manipulations */
+            std::chrono::nanoseconds _fixedTimeStep; /*!< The duration of a fixed step (0 if disabled) */
+            unsigned int _maxSubSteps; /*!< The maximum number of fixed steps in a tick */
+            bool _batchSubSteps; /*!< true if the fixed steps of a tick are run as a single update */
+            std::chrono::nanoseconds _accumulator; /*!< The time not consumed by fixed steps yet */
+            unsigned int _subSteps; /*!< The number of fixed steps run by the last tick */
             std::vector<ErrorReport> _errors; /*!< The errors that happened since getErrors() was last called */
+#ifdef JFECS_PROFILING
+            SystemTracer _tracer; /*!< Records the callback calls when tracing */
+#endif
         };
 
 
         template<typename T, typename... Params>
         void SystemManager::addSystem(Params... params)
         {
-            auto system = _systems.find(internal::getTypeIndex<T>());
-            if (system != _systems.end()) {
+            addSystem<T>(SystemOrder(), params...);
+        }
+
+        template<typename T, typename... Params>
+        void SystemManager::addSystem(const SystemOrder &order, Params... params)
+        {
+            if (findSystem(internal::getTypeIndex<T>()) != nullptr) {
                 throw SystemAlreadyExistingException("Systen already existing", "addSystem");
             }
             T *newSys = new T(params...);
-            _systems.insert(std::make_pair(internal::getTypeIndex<T>(), std::make_pair(NOT_STARTED, newSys)));
+            insertSystem(internal::getTypeIndex<T>(), newSys, order);
         }
 
         template<typename T>
         void SystemManager::removeSystem()
         {
-            auto system = _systems.find(internal::getTypeIndex<T>());
-            if (system == _systems.end()) {
-                throw SystemNotFoundException("System not found", "stopSystem");
-            }
-            switch (system->second.first) {
+            SystemInfo &system = findSystem(internal::getTypeIndex<T>(), "removeSystem");
+            switch (system.state) {
             case NOT_STARTED:
-                delete system.second.second;
-                _systems.erase(system);
+                eraseSystem(system);
                 break;
             case AWAKING:
-                throw SystemLogicalException("Can not tear down an AWAKING system", "stopSystem");
+                throw SystemLogicalException("Can not tear down an AWAKING system", "removeSystem");
             case STARTING:
-                throw SystemLogicalException("Can not tear down a STARTING system", "stopSystem");
+                throw SystemLogicalException("Can not tear down a STARTING system", "removeSystem");
             case RUNNING:
-                throw SystemLogicalException("Can not tear down a RUNNING system", "stopSystem");
+                throw SystemLogicalException("Can not tear down a RUNNING system", "removeSystem");
             case STOPPING:
-                throw SystemLogicalException("Can not tear down a STOPPING system", "stopSystem");
+                throw SystemLogicalException("Can not tear down a STOPPING system", "removeSystem");
             case STOPPED:
-                system->second.first = TEARING_DOWN;
+                system.state = TEARING_DOWN;
                 break;
             case TEARING_DOWN:
-                throw SystemLogicalException("Can not stop a TEARING_DOWN system", "stopSystem");
+                throw SystemLogicalException("Can not stop a TEARING_DOWN system", "removeSystem");
             }
         }
 
         template<typename T>
         void SystemManager::stopSystem()
         {
-            auto system = _systems.find(internal::getTypeIndex<T>());
-            if (system == _systems.end()) {
-                throw SystemNotFoundException("System not found", "stopSystem");
-            }
-            switch (system->second.first) {
+            SystemInfo &system = findSystem(internal::getTypeIndex<T>(), "stopSystem");
+            switch (system.state) {
             case NOT_STARTED:
                 throw SystemLogicalException("Can not stop a NOT_STARTED system", "stopSystem");
             case AWAKING:
@@ -244,7 +473,7 @@ namespace jf {
             case STARTING:
                 throw SystemLogicalException("Can not stop a STARTING system", "stopSystem");
             case RUNNING:
-                system->second.first = STOPPING;
+                system.state = STOPPING;
                 break;
             case STOPPING:
                 throw SystemLogicalException("Can not stop a STOPPING system", "stopSystem");
@@ -258,13 +487,10 @@ namespace jf {
         template<typename T>
         void SystemManager::startSystem()
         {
-            auto system = _systems.find(internal::getTypeIndex<T>());
-            if (system == _systems.end()) {
-                throw SystemNotFoundException("System not found", "startSystem");
-            }
-            switch (system->second.first) {
+            SystemInfo &system = findSystem(internal::getTypeIndex<T>(), "startSystem");
+            switch (system.state) {
             case NOT_STARTED:
-                system->second.first = AWAKING;
+                system.state = AWAKING;
                 break;
             case AWAKING:
                 throw SystemLogicalException("Can not start an AWAKING system", "startSystem");
@@ -275,7 +501,7 @@ namespace jf {
             case STOPPING:
                 throw SystemLogicalException("Can not start a STOPPING system", "startSystem");
             case STOPPED:
-                system->second.first = STARTING;
+                system.state = STARTING;
                 break;
             case TEARING_DOWN:
                 throw SystemLogicalException("Can not start a TEARING_DOWN system", "startSystem");
@@ -285,21 +511,13 @@ namespace jf {
         template<typename T>
         jf::systems::SystemState jf::systems::SystemManager::getState() const
         {
-            const auto system = _systems.find(internal::getTypeIndex<T>());
-            if (system == _systems.end()) {
-                throw SystemNotFoundException("System not found", "getState");
-            }
-            return system->second.first;
+            return findSystem(internal::getTypeIndex<T>(), "getState").state;
         }
 
         template<typename T>
         T &jf::systems::SystemManager::getSystem()
         {
-            auto system = _systems.find(internal::getTypeIndex<T>());
-            if (system == _systems.end()) {
-                throw SystemNotFoundException("System not found", "getSystem");
-            }
-            return *static_cast<T *>(system->second.second);
+            return *static_cast<T *>(findSystem(internal::getTypeIndex<T>(), "getSystem").system);
         }
 
     }
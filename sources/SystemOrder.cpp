@@ -0,0 +1,36 @@
+/*
+** EPITECH PROJECT, 2018
+** JFEntityComponentSystem
+** File description:
+** SystemOrder.cpp
+*/
+
+/* Created the 16/10/2026 at 20:26 by jfrabel */
+
+#include "SystemOrder.hpp"
+
+jf::systems::SystemOrder::SystemOrder(jf::systems::SystemPhase phase, int priority)
+    : _phase(phase), _priority(priority), _before(), _after()
+{
+
+}
+
+jf::systems::SystemPhase jf::systems::SystemOrder::getPhase() const
+{
+    return _phase;
+}
+
+int jf::systems::SystemOrder::getPriority() const
+{
+    return _priority;
+}
+
+const std::vector<std::type_index> &jf::systems::SystemOrder::getBefore() const
+{
+    return _before;
+}
+
+const std::vector<std::type_index> &jf::systems::SystemOrder::getAfter() const
+{
+    return _after;
+}
@@ -0,0 +1,126 @@
+/*
+** EPITECH PROJECT, 2018
+** JFEntityComponentSystem
+** File description:
+** SystemOrder.hpp
+*/
+
+/* Created the 16/10/2026 at 20:26 by jfrabel */
+
+#ifndef JFENTITYCOMPONENTSYSTEM_SYSTEMORDER_HPP
+#define JFENTITYCOMPONENTSYSTEM_SYSTEMORDER_HPP
+
+#include <typeindex>
+#include <vector>
+#include "Internal.hpp"
+
+/*!
+ * @namespace jf
+ * @brief The jfecs library namespace
+ */
+namespace jf {
+
+    /*!
+     * @namespace jf::systems
+     * @brief A namespace used for all system related classes
+     */
+    namespace systems {
+
+        /*!
+         * @enum SystemPhase
+         * @brief The phases of a tick, all the systems of a phase are updated before the systems of the next one
+         */
+        enum SystemPhase {
+            PRE_UPDATE, /*!< Systems preparing the frame (inputs, network...) */
+            FIXED_UPDATE, /*!< Systems updated with a fixed time step when enabled (see SystemManager::setFixedTimeStep) */
+            UPDATE, /*!< The default phase, game logic */
+            POST_UPDATE, /*!< Systems consuming the result of the update (transforms, collisions...) */
+            RENDER_PREP /*!< Systems preparing the data used to render the frame */
+        };
+
+        /*!
+         * @class SystemOrder
+         * @brief Where a system is updated in a tick
+         *
+         * Systems are updated phase by phase. Inside a phase a system is updated after the systems it must come after
+         * and before the systems it must come before. Then systems with a higher priority come first
+         * and systems added first come first.
+         * Constraints on systems that are not added are ignored.
+         */
+        class SystemOrder {
+        public:
+            /*!
+             * @brief ctor
+             * @param phase The phase of the system
+             * @param priority The priority of the system in its phase (higher comes first)
+             */
+            explicit SystemOrder(SystemPhase phase = UPDATE, int priority = 0);
+
+            /*!
+             * @brief Require the system to be updated before another one
+             * @tparam T The type of the other system
+             * @return The current instance
+             */
+            template<typename T>
+            SystemOrder &before()
+            {
+                _before.push_back(internal::getTypeIndex<T>());
+                return *this;
+            }
+
+            /*!
+             * @brief Require the system to be updated after another one
+             * @tparam T The type of the other system
+             * @return The current instance
+             */
+            template<typename T>
+            SystemOrder &after()
+            {
+                _after.push_back(internal::getTypeIndex<T>());
+                return *this;
+            }
+
+            /*!
+             * @brief Get the phase of the system
+             * @return The phase of the system
+             */
+            SystemPhase getPhase() const;
+
+            /*!
+             * @brief Get the priority of the system in its phase
+             * @return The priority of the system (higher comes first)
+             */
+            int getPriority() const;
+
+            /*!
+             * @brief Get the systems this system must be updated before
+             * @return The types of the systems
+             */
+            const std::vector<std::type_index> &getBefore() const;
+
+            /*!
+             * @brief Get the systems this system must be updated after
+             * @return The types of the systems
+             */
+            const std::vector<std::type_index> &getAfter() const;
+
+        private:
+            SystemPhase _phase; /*!< The phase of the system */
+            int _priority; /*!< The priority of the system in its phase */
+            std::vector<std::type_index> _before; /*!< The systems this system must be updated before */
+            std::vector<std::type_index> _after; /*!< The systems this system must be updated after */
+        };
+    }
+}
+
+#else
+
+namespace jf {
+
+    namespace systems {
+
+        class SystemOrder;
+    }
+}
+
+#endif //JFENTITYCOMPONENTSYSTEM_SYSTEMORDER_HPP
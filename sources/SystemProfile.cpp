@@ -0,0 +1,142 @@
+/*
+** EPITECH PROJECT, 2018
+** JFEntityComponentSystem
+** File description:
+** SystemProfile.cpp
+*/
+
+/* Created the 16/10/2026 at 21:40 by jfrabel */
+
+#include "SystemProfile.hpp"
+
+#ifdef JFECS_PROFILING
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#ifdef __GNUG__
+#include <cxxabi.h>
+#endif
+
+jf::systems::TimingHistory::TimingHistory()
+    : _durations(), _next(0)
+{
+
+}
+
+void jf::systems::TimingHistory::record(const std::chrono::nanoseconds &duration)
+{
+    if (_durations.size() < windowSize) {
+        _durations.push_back(duration.count());
+        return;
+    }
+    _durations[_next] = duration.count();
+    _next = (_next + 1) % windowSize;
+}
+
+jf::systems::TimingStats jf::systems::TimingHistory::getStats() const
+{
+    TimingStats stats = {0, std::chrono::nanoseconds(0), std::chrono::nanoseconds(0), std::chrono::nanoseconds(0), std::chrono::nanoseconds(0)};
+    if (_durations.empty())
+        return stats;
+    std::vector<int64_t> sorted(_durations);
+    std::sort(sorted.begin(), sorted.end());
+    int64_t total = 0;
+    for (auto duration : sorted)
+        total += duration;
+    std::size_t p99 = (sorted.size() * 99 + 99) / 100 - 1;
+    stats.samples = sorted.size();
+    stats.min = std::chrono::nanoseconds(sorted.front());
+    stats.mean = std::chrono::nanoseconds(total / static_cast<int64_t>(sorted.size()));
+    stats.p99 = std::chrono::nanoseconds(sorted[p99]);
+    stats.max = std::chrono::nanoseconds(sorted.back());
+    return stats;
+}
+
+jf::systems::SystemTracer::SystemTracer()
+    : _tracing(false), _start(), _events(), _mutex()
+{
+
+}
+
+void jf::systems::SystemTracer::start()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _events.clear();
+    _start = std::chrono::steady_clock::now();
+    _tracing = true;
+}
+
+bool jf::systems::SystemTracer::stop(const std::string &path)
+{
+    static const char *callbacks[CALLBACK_COUNT] = {"onAwake", "onStart", "onUpdate", "onStop", "onTearDown"};
+    std::lock_guard<std::mutex> lock(_mutex);
+    _tracing = false;
+    std::ofstream file(path);
+    if (!file)
+        return false;
+    file << "{\"traceEvents\":[";
+    for (std::size_t i = 0; i < _events.size(); ++i) {
+        const TraceEvent &event = _events[i];
+        std::string name = event.type.name();
+#ifdef __GNUG__
+        int status = 0;
+        std::unique_ptr<char, void (*)(void *)> demangled(abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status), std::free);
+        if (status == 0 && demangled)
+            name = demangled.get();
+#endif
+        std::string escaped;
+        for (char c : name) {
+            if (c == '"' || c == '\\')
+                escaped += '\\';
+            escaped += c;
+        }
+        auto begin = std::chrono::duration<double, std::micro>(event.begin - _start).count();
+        auto duration = std::chrono::duration<double, std::micro>(event.end - event.begin).count();
+        file << (i == 0 ? "" : ",") << "\n{\"name\":\"" << escaped << "\",\"cat\":\"" << callbacks[event.callback]
+             << "\",\"ph\":\"X\",\"ts\":" << begin << ",\"dur\":" << duration << ",\"pid\":1,\"tid\":" << event.thread << "}";
+    }
+    file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    _events.clear();
+    return static_cast<bool>(file);
+}
+
+bool jf::systems::SystemTracer::isTracing() const
+{
+    return _tracing;
+}
+
+void jf::systems::SystemTracer::record(const std::type_index &type, jf::systems::SystemCallback callback,
+                                       const std::chrono::steady_clock::time_point &begin,
+                                       const std::chrono::steady_clock::time_point &end)
+{
+    TraceEvent event = {type, callback, begin, end, getThreadIndex()};
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_tracing)
+        _events.push_back(event);
+}
+
+std::size_t jf::systems::SystemTracer::getThreadIndex()
+{
+    static std::atomic<std::size_t> threads(0);
+    static thread_local std::size_t index = threads++;
+    return index;
+}
+
+jf::systems::ProfileScope::ProfileScope(jf::systems::TimingHistory &history, jf::systems::SystemTracer &tracer,
+                                        const std::type_index &type, jf::systems::SystemCallback callback)
+    : _history(history), _tracer(tracer), _type(type), _callback(callback), _begin(std::chrono::steady_clock::now())
+{
+
+}
+
+jf::systems::ProfileScope::~ProfileScope()
+{
+    auto end = std::chrono::steady_clock::now();
+    _history.record(std::chrono::duration_cast<std::chrono::nanoseconds>(end - _begin));
+    if (_tracer.isTracing())
+        _tracer.record(_type, _callback, _begin, end);
+}
+
+#endif
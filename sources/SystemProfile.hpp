@@ -0,0 +1,231 @@
+/*
+** EPITECH PROJECT, 2018
+** JFEntityComponentSystem
+** File description:
+** SystemProfile.hpp
+*/
+
+/* Created the 16/10/2026 at 21:40 by jfrabel */
+
+#ifndef JFENTITYCOMPONENTSYSTEM_SYSTEMPROFILE_HPP
+#define JFENTITYCOMPONENTSYSTEM_SYSTEMPROFILE_HPP
+
+#ifdef JFECS_PROFILING
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <typeindex>
+#include <vector>
+
+#define JFECS_PROFILE_SCOPE(history, tracer, type, callback) jf::systems::ProfileScope profileScope(history, tracer, type, callback)
+
+#else
+
+#define JFECS_PROFILE_SCOPE(history, tracer, type, callback)
+
+#endif
+
+#ifdef JFECS_PROFILING
+
+/*!
+ * @namespace jf
+ * @brief The jfecs library namespace
+ */
+namespace jf {
+
+    /*!
+     * @namespace jf::systems
+     * @brief A namespace used for all system related classes
+     */
+    namespace systems {
+
+        /*!
+         * @enum SystemCallback
+         * @brief The callbacks of a system timed by the SystemManager
+         */
+        enum SystemCallback {
+            CALLBACK_ON_AWAKE, /*!< ISystem::onAwake */
+            CALLBACK_ON_START, /*!< ISystem::onStart */
+            CALLBACK_ON_UPDATE, /*!< ISystem::onUpdate */
+            CALLBACK_ON_STOP, /*!< ISystem::onStop */
+            CALLBACK_ON_TEARDOWN, /*!< ISystem::onTearDown */
+            CALLBACK_COUNT /*!< The number of callbacks */
+        };
+
+        /*!
+         * @struct TimingStats
+         * @brief The statistics of the last calls of a callback
+         */
+        struct TimingStats {
+            std::size_t samples; /*!< The number of calls the statistics are computed on */
+            std::chrono::nanoseconds min; /*!< The fastest call */
+            std::chrono::nanoseconds mean; /*!< The average call */
+            std::chrono::nanoseconds p99; /*!< 99% of the calls were this fast or faster */
+            std::chrono::nanoseconds max; /*!< The slowest call */
+        };
+
+        /*!
+         * @class TimingHistory
+         * @brief The durations of the last calls of a callback
+         */
+        class TimingHistory {
+        public:
+            static constexpr std::size_t windowSize = 256; /*!< The number of calls kept */
+
+        public:
+            /*!
+             * @brief ctor
+             */
+            TimingHistory();
+
+            /*!
+             * @brief Add the duration of a call, the oldest call is forgotten once windowSize calls are kept
+             * @param duration The duration of the call
+             */
+            void record(const std::chrono::nanoseconds &duration);
+
+            /*!
+             * @brief Get the statistics of the kept calls
+             * @return The statistics (all zero if no call was recorded)
+             */
+            TimingStats getStats() const;
+
+        private:
+            std::vector<int64_t> _durations; /*!< The durations of the calls in nanoseconds */
+            std::size_t _next; /*!< Where the next duration is written once the window is full */
+        };
+
+        /*!
+         * @class SystemTracer
+         * @brief Records the calls of the system callbacks and write them as a Chrome trace (chrome://tracing)
+         */
+        class SystemTracer {
+        public:
+            /*!
+             * @brief ctor
+             */
+            SystemTracer();
+
+            /*!
+             * @brief Forget the recorded calls and start recording
+             */
+            void start();
+
+            /*!
+             * @brief Stop recording and write the recorded calls to a file
+             * @param path The path of the JSON file to write
+             * @return true if the file was written
+             */
+            bool stop(const std::string &path);
+
+            /*!
+             * @brief Get if the calls are recorded
+             * @return true if recording
+             */
+            bool isTracing() const;
+
+            /*!
+             * @brief Record a call, can be called from several threads at once
+             * @param type The type of the system
+             * @param callback The called callback
+             * @param begin The time the call started
+             * @param end The time the call ended
+             */
+            void record(const std::type_index &type, SystemCallback callback,
+                        const std::chrono::steady_clock::time_point &begin, const std::chrono::steady_clock::time_point &end);
+
+        private:
+            /*!
+             * @struct TraceEvent
+             * @brief A recorded call
+             */
+            struct TraceEvent {
+                std::type_index type; /*!< The type of the system */
+                SystemCallback callback; /*!< The called callback */
+                std::chrono::steady_clock::time_point begin; /*!< The time the call started */
+                std::chrono::steady_clock::time_point end; /*!< The time the call ended */
+                std::size_t thread; /*!< The index of the calling thread */
+            };
+
+            /*!
+             * @brief Get a small index for the current thread
+             * @return The index of the current thread
+             */
+            static std::size_t getThreadIndex();
+
+        private:
+            std::atomic<bool> _tracing; /*!< true if recording */
+            std::chrono::steady_clock::time_point _start; /*!< The time the recording started */
+            std::vector<TraceEvent> _events; /*!< The recorded calls */
+            std::mutex _mutex; /*!< Mutex protecting _events */
+        };
+
+        /*!
+         * @class ProfileScope
+         * @brief Times a call from its construction to its destruction (use JFECS_PROFILE_SCOPE)
+         */
+        class ProfileScope {
+        public:
+            /*!
+             * @brief ctor, start timing
+             * @param history The history of the callback
+             * @param tracer The tracer to give the call to if it is recording
+             * @param type The type of the system
+             * @param callback The called callback
+             */
+            ProfileScope(TimingHistory &history, SystemTracer &tracer, const std::type_index &type, SystemCallback callback);
+
+            /*!
+             * @brief cpy ctor
+             * @param other The scope to copy
+             */
+            ProfileScope(const ProfileScope &other) = delete;
+
+            /*!
+             * @brief dtor, stop timing and record the call
+             */
+            ~ProfileScope();
+
+            /*!
+             * @brief Assignment operator
+             * @param other The scope to assign to
+             * @return The current instance
+             */
+            ProfileScope &operator=(const ProfileScope &other) = delete;
+
+        private:
+            TimingHistory &_history; /*!< The history of the callback */
+            SystemTracer &_tracer; /*!< The tracer */
+            std::type_index _type; /*!< The type of the system */
+            SystemCallback _callback; /*!< The called callback */
+            std::chrono::steady_clock::time_point _begin; /*!< The time the call started */
+        };
+    }
+}
+
+#endif
+
+#else
+
+#ifdef JFECS_PROFILING
+
+namespace jf {
+
+    namespace systems {
+
+        struct TimingStats;
+
+        class TimingHistory;
+
+        class SystemTracer;
+
+        class ProfileScope;
+    }
+}
+
+#endif
+
+#endif //JFENTITYCOMPONENTSYSTEM_SYSTEMPROFILE_HPP
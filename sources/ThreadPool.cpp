@@ -0,0 +1,143 @@
+/*
+** EPITECH PROJECT, 2018
+** JFEntityComponentSystem
+** File description:
+** ThreadPool.cpp
+*/
+
+/* Created the 16/10/2026 at 18:12 by jfrabel */
+
+#include "ThreadPool.hpp"
+
+jf::ThreadPool &jf::ThreadPool::getInstance()
+{
+    static ThreadPool instance;
+    return instance;
+}
+
+jf::ThreadPool::ThreadPool()
+    : _workers(), _runMutex(), _mutex(), _wakeUp(), _done(), _task(nullptr), _taskCount(0), _nextTask(0),
+    _busyWorkers(0), _job(0), _stopping(false), _error()
+{
+    std::size_t count = std::thread::hardware_concurrency();
+    startWorkers(count > 1 ? count - 1 : 0);
+}
+
+jf::ThreadPool::~ThreadPool()
+{
+    stopWorkers();
+}
+
+std::size_t jf::ThreadPool::getThreadCount() const
+{
+    return _workers.size() + 1;
+}
+
+void jf::ThreadPool::setThreadCount(std::size_t count)
+{
+    std::lock_guard<std::mutex> runLock(_runMutex);
+    stopWorkers();
+    startWorkers(count > 1 ? count - 1 : 0);
+}
+
+void jf::ThreadPool::run(std::size_t taskCount, const std::function<void(std::size_t)> &task)
+{
+    if (taskCount == 0)
+        return;
+    if (_workers.empty() || taskCount == 1 || insideTask()) {
+        for (std::size_t i = 0; i < taskCount; ++i)
+            task(i);
+        return;
+    }
+    std::lock_guard<std::mutex> runLock(_runMutex);
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _task = &task;
+        _taskCount = taskCount;
+        _nextTask = 0;
+        _busyWorkers = _workers.size();
+        _error = nullptr;
+        ++_job;
+    }
+    _wakeUp.notify_all();
+    execute();
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _done.wait(lock, [this]() {
+            return _busyWorkers == 0;
+        });
+        _task = nullptr;
+        error = _error;
+        _error = nullptr;
+    }
+    if (error)
+        std::rethrow_exception(error);
+}
+
+void jf::ThreadPool::startWorkers(std::size_t count)
+{
+    uint64_t job;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = false;
+        job = _job;
+    }
+    for (std::size_t i = 0; i < count; ++i)
+        _workers.emplace_back(&ThreadPool::workerLoop, this, job);
+}
+
+void jf::ThreadPool::stopWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _wakeUp.notify_all();
+    for (auto &worker : _workers)
+        worker.join();
+    _workers.clear();
+}
+
+void jf::ThreadPool::workerLoop(uint64_t lastJob)
+{
+    while (true) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _wakeUp.wait(lock, [this, lastJob]() {
+            return _stopping || _job != lastJob;
+        });
+        if (_stopping)
+            return;
+        lastJob = _job;
+        lock.unlock();
+        execute();
+        lock.lock();
+        if (--_busyWorkers == 0)
+            _done.notify_all();
+    }
+}
+
+void jf::ThreadPool::execute()
+{
+    insideTask() = true;
+    while (true) {
+        std::size_t index = _nextTask.fetch_add(1);
+        if (index >= _taskCount)
+            break;
+        try {
+            (*_task)(index);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_error)
+                _error = std::current_exception();
+            _nextTask = _taskCount;
+        }
+    }
+    insideTask() = false;
+}
+
+bool &jf::ThreadPool::insideTask()
+{
+    static thread_local bool inside = false;
+    return inside;
+}
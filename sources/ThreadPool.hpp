@@ -0,0 +1,144 @@
+/*
+** EPITECH PROJECT, 2018
+** JFEntityComponentSystem
+** File description:
+** ThreadPool.hpp
+*/
+
+/* Created the 16/10/2026 at 18:12 by jfrabel */
+
+#ifndef JFENTITYCOMPONENTSYSTEM_THREADPOOL_HPP
+#define JFENTITYCOMPONENTSYSTEM_THREADPOOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*!
+ * @namespace jf
+ * @brief The jfecs library namespace
+ */
+namespace jf {
+
+    /*!
+     * @class ThreadPool
+     * @brief A singleton class owning the worker threads used by the parallel parts of the ecs
+     *
+     * The pool runs one job at a time. A job is a number of tasks identified by their index,
+     * the worker threads and the calling thread take the tasks one by one until all of them are done.
+     * A job started from inside a task is run on the current thread.
+     */
+    class ThreadPool final {
+    public:
+        /*!
+         * @brief cpy ctor
+         * @param other The pool to copy
+         */
+        ThreadPool(const ThreadPool &other) = delete;
+
+        /*!
+         * @brief dtor, wait for the workers to stop
+         */
+        ~ThreadPool();
+
+        /*!
+         * @brief A static method used to retrieve the ThreadPool instance
+         * @return A reference to the instance
+         */
+        static ThreadPool &getInstance();
+
+    private:
+        /*!
+         * @brief ctor, start one thread per hardware thread (the calling thread included)
+         */
+        ThreadPool();
+
+    public:
+        /*!
+         * @brief Assignment operator
+         * @param other The pool to assign to
+         * @return The current instance
+         */
+        ThreadPool &operator=(const ThreadPool &other) = delete;
+
+    public:
+        /*!
+         * @brief Get the number of threads running the jobs
+         * @return The number of worker threads plus the calling thread
+         */
+        std::size_t getThreadCount() const;
+
+        /*!
+         * @brief Set the number of threads running the jobs
+         * @param count The number of worker threads plus the calling thread (1 to run everything on the calling thread)
+         *
+         * Must not be called from a task
+         */
+        void setThreadCount(std::size_t count);
+
+        /*!
+         * @brief Run a job and wait for all its tasks to be done
+         * @param taskCount The number of tasks of the job
+         * @param task The function called with the index of each task
+         * @throw Rethrow the first exception thrown by a task once the running tasks are done, the tasks not started yet are skipped
+         */
+        void run(std::size_t taskCount, const std::function<void(std::size_t)> &task);
+
+    private:
+        /*!
+         * @brief Start the worker threads
+         * @param count The number of worker threads to start
+         */
+        void startWorkers(std::size_t count);
+
+        /*!
+         * @brief Stop and join the worker threads
+         */
+        void stopWorkers();
+
+        /*!
+         * @brief The loop of a worker thread
+         * @param lastJob The job counter when the worker was started, read before the thread exists so no later job is missed
+         */
+        void workerLoop(uint64_t lastJob);
+
+        /*!
+         * @brief Take and run the tasks of the current job until there is no task left
+         */
+        void execute();
+
+        /*!
+         * @brief Get if the current thread is running a task
+         * @return A reference to the flag of the current thread
+         */
+        static bool &insideTask();
+
+    private:
+        std::vector<std::thread> _workers; /*!< The worker threads */
+        std::mutex _runMutex; /*!< Mutex ensuring only one job is running */
+        std::mutex _mutex; /*!< Mutex protecting the job state */
+        std::condition_variable _wakeUp; /*!< Used to wake up workers when a job starts or on stop */
+        std::condition_variable _done; /*!< Used to wake up the caller when all workers are done */
+        const std::function<void(std::size_t)> *_task; /*!< The task of the current job */
+        std::size_t _taskCount; /*!< The number of tasks of the current job */
+        std::atomic<std::size_t> _nextTask; /*!< The index of the next task to run */
+        std::size_t _busyWorkers; /*!< The number of workers still running the current job */
+        uint64_t _job; /*!< Incremented each time a job starts */
+        bool _stopping; /*!< true when the workers should stop */
+        std::exception_ptr _error; /*!< The first exception thrown by a task of the current job */
+    };
+}
+
+#else
+
+namespace jf {
+
+    class ThreadPool;
+}
+
+#endif //JFENTITYCOMPONENTSYSTEM_THREADPOOL_HPP
@@ -0,0 +1,352 @@
+/*
+** EPITECH PROJECT, 2018
+** JFEntityComponentSystem
+** File description:
+** View.hpp
+*/
+
+/* Created the 16/10/2026 at 14:37 by jfrabel */
+
+#ifndef JFENTITYCOMPONENTSYSTEM_VIEW_HPP
+#define JFENTITYCOMPONENTSYSTEM_VIEW_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Internal.hpp"
+#include "DynamicBitset.hpp"
+#include "Entity.hpp"
+#include "EntityHandler.hpp"
+#include "ComponentHandler.hpp"
+#include "ThreadPool.hpp"
+
+/*!
+ * @namespace jf
+ * @brief The jfecs library namespace
+ */
+namespace jf {
+
+    /*!
+     * @namespace jf::entities
+     * @brief Namespace for entity related classes
+     */
+    namespace entities {
+
+        /*!
+         * @class BaseView
+         * @brief A class used internaly by the EntityManager to update views without knowing their types
+         */
+        class BaseView {
+        public:
+            /*!
+             * @brief ctor
+             * @param types The component types watched by the view
+             */
+            explicit BaseView(const std::vector<std::type_index> &types): _types(types)
+            {}
+
+            /*!
+             * @brief dtor
+             */
+            virtual ~BaseView() = default;
+
+            /*!
+             * @brief Check again if an entity matches the view after one of its components changed
+             * @param entity The entity to check
+             */
+            virtual void update(Entity &entity) = 0;
+
+            /*!
+             * @brief Remove an entity from the view
+             * @param entity The entity to remove
+             */
+            virtual void remove(Entity &entity) = 0;
+
+            /*!
+             * @brief Get the component types watched by the view
+             * @return The types of components required by the view
+             */
+            const std::vector<std::type_index> &getTypes() const
+            {
+                return _types;
+            }
+
+        private:
+            std::vector<std::type_index> _types; /*!< The component types required by the view */
+        };
+
+        /*!
+         * @class View
+         * @brief A persistent list of the entities having a set of components
+         * @tparam C The first required component
+         * @tparam Others The others required components (can be empty)
+         *
+         * A view is created and kept up to date by the EntityManager (see EntityManager::view).
+         * Entities are added and removed when components are assigned or removed
+         * so iterating a view only costs the number of matching entities.
+         * Do not store a view, always get it from the EntityManager.
+         */
+        template<typename C, typename... Others>
+        class View final : public BaseView {
+        public:
+            /*!
+             * @brief ctor
+             * @param enabled The enabled state of the entities, indexed by entity id
+             */
+            explicit View(const internal::DynamicBitset &enabled)
+                : BaseView({internal::getTypeIndex<C>(), internal::getTypeIndex<Others>()...}),
+                _entries(), _ids(), _positions(), _enabled(enabled), _iterating(0), _tombstones(0)
+            {}
+
+            /*!
+             * @brief cpy ctor
+             * @param other The view to copy
+             */
+            View(const View<C, Others...> &other) = delete;
+
+            /*!
+             * @brief dtor
+             */
+            ~View() override = default;
+
+        public:
+            /*!
+             * @brief Assignment operator
+             * @param other The view to assign to
+             * @return this view
+             */
+            View<C, Others...> &operator=(const View<C, Others...> &other) = delete;
+
+        public:
+            /*!
+             * @brief Check again if an entity matches the view after one of its components changed
+             * @param entity The entity to check
+             */
+            void update(Entity &entity) override
+            {
+                std::size_t position = getPosition(entity);
+                if (!entity.hasComponents<C, Others...>()) {
+                    if (position != npos)
+                        erase(entity, position);
+                    return;
+                }
+                Entry entry(&entity, entity.getComponent<C>().get(), entity.getComponent<Others>().get()...);
+                if (position != npos) {
+                    _entries[position] = entry;
+                    return;
+                }
+                uint64_t index = entity.getID().getID();
+                if (index >= _positions.size())
+                    _positions.resize(index + 1, npos);
+                _positions[index] = _entries.size();
+                _entries.push_back(entry);
+                _ids.push_back(index);
+            }
+
+            /*!
+             * @brief Remove an entity from the view
+             * @param entity The entity to remove
+             */
+            void remove(Entity &entity) override
+            {
+                std::size_t position = getPosition(entity);
+                if (position != npos)
+                    erase(entity, position);
+            }
+
+            /*!
+             * @brief Apply a fuction/functor/lamda... to all entities of the view
+             * @param func The function to apply
+             * @param onlyEnabled apply only to enabled entities
+             *
+             * Entities removed from the view during the iteration will not be visited.
+             * Entities added to the view during the iteration may or may not be visited.
+             */
+            void applyToEach(typename std::common_type<std::function<void(EntityHandler, components::ComponentHandler<C>, components::ComponentHandler<Others>...)>>::type func, bool onlyEnabled = true)
+            {
+                ++_iterating;
+                try {
+                    for (std::size_t i = 0; i < _entries.size(); ++i) {
+                        if (onlyEnabled && !_enabled.test(_ids[i]))
+                            continue;
+                        Entry entry = _entries[i];
+                        if (std::get<0>(entry) != nullptr)
+                            call(func, entry, std::index_sequence_for<C, Others...>());
+                    }
+                } catch (...) {
+                    endIteration();
+                    throw;
+                }
+                endIteration();
+            }
+
+            /*!
+             * @brief Apply a fuction/functor/lamda... to all entities of the view using the ThreadPool
+             * @param func The function to apply, called concurrently from several threads
+             * @param onlyEnabled apply only to enabled entities
+             * @param grainSize The number of entries given to a thread at once
+             * @throw Rethrow the first exception thrown by func once the running chunks are done (the others are skipped)
+             *
+             * The entries are split in chunks of grainSize entries run by the worker threads and the calling thread.
+             * func may read and write the components it receives and use handlers,
+             * but must not create or delete entities, enable or disable entities, assign or remove components, or emit events.
+             * Use EntityManager::safeDeleteEntity to delete entities from func.
+             */
+            void parallelApplyToEach(typename std::common_type<std::function<void(EntityHandler, components::ComponentHandler<C>, components::ComponentHandler<Others>...)>>::type func, bool onlyEnabled = true, std::size_t grainSize = 256)
+            {
+                if (grainSize == 0)
+                    grainSize = 1;
+                std::size_t count = _entries.size();
+                ++_iterating;
+                try {
+                    ThreadPool::getInstance().run((count + grainSize - 1) / grainSize, [this, &func, onlyEnabled, grainSize, count](std::size_t chunk) {
+                        std::size_t end = std::min(count, (chunk + 1) * grainSize);
+                        for (std::size_t i = chunk * grainSize; i < end; ++i) {
+                            if (onlyEnabled && !_enabled.test(_ids[i]))
+                                continue;
+                            const Entry &entry = _entries[i];
+                            if (std::get<0>(entry) != nullptr)
+                                call(func, entry, std::index_sequence_for<C, Others...>());
+                        }
+                    });
+                } catch (...) {
+                    endIteration();
+                    throw;
+                }
+                endIteration();
+            }
+
+            /*!
+             * @brief Get all the entities of the view
+             * @param onlyEnabled Get only enabled entities
+             * @return A vector of EntityHandle with the matching entities (empty vector if no entity is found)
+             */
+            std::vector<EntityHandler> getEntities(bool onlyEnabled = true) const
+            {
+                std::vector<EntityHandler> matching;
+                for (std::size_t i = 0; i < _entries.size(); ++i) {
+                    if (onlyEnabled && !_enabled.test(_ids[i]))
+                        continue;
+                    Entity *entity = std::get<0>(_entries[i]);
+                    if (entity != nullptr)
+                        matching.emplace_back(entity);
+                }
+                return matching;
+            }
+
+            /*!
+             * @brief Get the number of entities in the view (enabled or not)
+             * @return The number of entities matching the view
+             */
+            std::size_t size() const
+            {
+                return _entries.size() - _tombstones;
+            }
+
+        private:
+            using Entry = std::tuple<Entity *, C *, Others *...>; /*!< An entity and its components */
+
+            /*!
+             * @brief Get the position of an entity in the entries
+             * @param entity The entity to look for
+             * @return The position of the entity or npos if not in the view
+             */
+            std::size_t getPosition(Entity &entity) const
+            {
+                uint64_t index = entity.getID().getID();
+                if (index >= _positions.size())
+                    return npos;
+                return _positions[index];
+            }
+
+            /*!
+             * @brief Remove an entry, the last entry is moved in place of the removed one
+             * @param entity The entity to remove
+             * @param position The position of the entity in the entries
+             *
+             * During an iteration the entry is only marked as removed and the entries are packed afterward.
+             */
+            void erase(Entity &entity, std::size_t position)
+            {
+                _positions[entity.getID().getID()] = npos;
+                if (_iterating != 0) {
+                    std::get<0>(_entries[position]) = nullptr;
+                    ++_tombstones;
+                    return;
+                }
+                if (position != _entries.size() - 1) {
+                    _entries[position] = _entries.back();
+                    _ids[position] = _ids.back();
+                    _positions[_ids[position]] = position;
+                }
+                _entries.pop_back();
+                _ids.pop_back();
+            }
+
+            /*!
+             * @brief End an iteration and pack the entries if it was the last one running
+             */
+            void endIteration()
+            {
+                if (--_iterating != 0 || _tombstones == 0)
+                    return;
+                std::size_t packed = 0;
+                for (std::size_t i = 0; i < _entries.size(); ++i) {
+                    Entity *entity = std::get<0>(_entries[i]);
+                    if (entity == nullptr)
+                        continue;
+                    _entries[packed] = _entries[i];
+                    _ids[packed] = _ids[i];
+                    _positions[_ids[packed]] = packed;
+                    ++packed;
+                }
+                _entries.resize(packed);
+                _ids.resize(packed);
+                _tombstones = 0;
+            }
+
+            /*!
+             * @brief Call a function with the content of an entry
+             * @tparam Func The type of the function
+             * @tparam Indexes The indexes of the components in the entry (starting at 0)
+             * @param func The function to call
+             * @param entry The entry to give to the function
+             */
+            template<typename Func, std::size_t... Indexes>
+            static void call(const Func &func, const Entry &entry, std::index_sequence<Indexes...>)
+            {
+                func(EntityHandler(std::get<0>(entry)),
+                    components::ComponentHandler<typename std::remove_pointer<typename std::tuple_element<Indexes + 1, Entry>::type>::type>(std::get<Indexes + 1>(entry))...);
+            }
+
+        private:
+            std::vector<Entry> _entries; /*!< The matching entities and their components */
+            std::vector<uint64_t> _ids; /*!< The id of the entity of each entry, read to skip disabled entities without reading them */
+            std::vector<std::size_t> _positions; /*!< For each entity id the position of the entity in _entries */
+            const internal::DynamicBitset &_enabled; /*!< The enabled state of the entities, owned by the EntityManager */
+            std::atomic<std::size_t> _iterating; /*!< The number of iterations currently running on the entries (systems may iterate a view concurrently) */
+            std::size_t _tombstones; /*!< The number of entries removed while iterating */
+
+            static constexpr std::size_t npos = static_cast<std::size_t>(-1); /*!< An invalid position */
+        };
+    }
+}
+
+#else
+
+namespace jf {
+
+    namespace entities {
+
+        class BaseView;
+
+        template<typename C, typename... Others>
+        class View;
+    }
+}
+
+#endif //JFENTITYCOMPONENTSYSTEM_VIEW_HPP